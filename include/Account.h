@@ -3,50 +3,47 @@
 #include <vector>
 #include <memory>
 #include <chrono>
+#include "AccountRegistry.h"
+#include "AccountPolicies.h"
+#include "Money.h"
 
-enum class AccountType {
-    SAVINGS,
-    CHECKING,
-    BUSINESS
-};
-
-class Transaction;
-
+// Fields and operations shared by every account type.
+// Accounts are plain records without virtual functions: Bank stores each
+// concrete type in its own contiguous table, batch code calls the concrete
+// type directly, and calls through an Account pointer switch on the type tag.
 class Account {
 protected:
     std::string accountNumber;
+    AccountId id;
     std::string accountHolderName;
-    double balance;
+    Money balance;
     AccountType type;
-    std::vector<std::shared_ptr<Transaction>> transactions;
     std::chrono::system_clock::time_point createdAt;
     bool isActive;
+    
+    Account(const std::string& holderName, AccountType accType, Money initialBalance = Money());
+    ~Account() = default;
 
 public:
-    Account(const std::string& holderName, AccountType accType, double initialBalance = 0.0);
-    virtual ~Account() = default;
-
     // Getters
     std::string getAccountNumber() const { return accountNumber; }
+    AccountId getId() const { return id; }
     std::string getAccountHolderName() const { return accountHolderName; }
-    double getBalance() const { return balance; }
+    Money getBalance() const { return balance; }
     AccountType getType() const { return type; }
     bool getIsActive() const { return isActive; }
     
-    // Account operations
-    virtual bool deposit(double amount);
-    virtual bool withdraw(double amount);
-    virtual bool transfer(Account& targetAccount, double amount);
+    // Account operations; withdraw and interest dispatch on the type tag
+    bool deposit(Money amount);
+    bool withdraw(Money amount);
+    bool transfer(Account& targetAccount, Money amount);
     
-    // Transaction history
-    void addTransaction(std::shared_ptr<Transaction> transaction);
-    std::vector<std::shared_ptr<Transaction>> getTransactions() const;
-    
-    // Interest calculation (for savings accounts)
-    virtual double calculateInterest() const { return 0.0; }
-    virtual void applyInterest();
+    // Interest calculation (for savings accounts); applyInterest returns the amount credited
+    Money calculateInterest() const;
+    Money applyInterest();
     
     // Account management
+    void setId(AccountId accountId) { id = accountId; }
     void deactivate() { isActive = false; }
     void activate() { isActive = true; }
     
@@ -59,46 +56,81 @@ protected:
     std::string getAccountTypePrefix() const;
 };
 
-class SavingsAccount : public Account {
+// Account type assembled from a withdrawal policy and an interest policy.
+// Derived is the concrete type, so policies can read its extra fields.
+template <typename Derived, typename WithdrawalPolicy, typename InterestPolicy>
+class AccountOf : public Account {
+protected:
+    AccountOf(const std::string& holderName, AccountType accType, Money initialBalance)
+        : Account(holderName, accType, initialBalance) {}
+
+public:
+    using Withdrawal = WithdrawalPolicy;
+    using Interest = InterestPolicy;
+    
+    bool withdraw(Money amount) {
+        if (!amount.isPositive() || !isActive || !WithdrawalPolicy::allows(self(), amount)) return false;
+        
+        balance -= amount;
+        return true;
+    }
+    
+    Money calculateInterest() const {
+        return InterestPolicy::accrued(self(), std::chrono::system_clock::now());
+    }
+    
+    Money applyInterest() {
+        auto now = std::chrono::system_clock::now();
+        Money interest = InterestPolicy::accrued(self(), now);
+        if (!interest.isPositive()) return Money();
+        
+        balance += interest;
+        InterestPolicy::credited(self(), now);
+        return interest;
+    }
+
+private:
+    Derived& self() { return static_cast<Derived&>(*this); }
+    const Derived& self() const { return static_cast<const Derived&>(*this); }
+};
+
+class SavingsAccount : public AccountOf<SavingsAccount, BalanceLimit, DailyInterest> {
 private:
     double interestRate;
     std::chrono::system_clock::time_point lastInterestDate;
 
 public:
-    SavingsAccount(const std::string& holderName, double initialBalance = 0.0);
-    
-    double calculateInterest() const override;
-    void applyInterest() override;
+    SavingsAccount(const std::string& holderName, Money initialBalance = Money());
     
     double getInterestRate() const { return interestRate; }
     void setInterestRate(double rate) { interestRate = rate; }
+    std::chrono::system_clock::time_point getLastInterestDate() const { return lastInterestDate; }
+    void setLastInterestDate(std::chrono::system_clock::time_point date) { lastInterestDate = date; }
 };
 
-class CheckingAccount : public Account {
+class CheckingAccount : public AccountOf<CheckingAccount, OverdraftLimit, NoInterest> {
 private:
-    double overdraftLimit;
+    Money overdraftLimit;
 
 public:
-    CheckingAccount(const std::string& holderName, double initialBalance = 0.0);
+    CheckingAccount(const std::string& holderName, Money initialBalance = Money());
     
-    bool withdraw(double amount) override;
-    
-    double getOverdraftLimit() const { return overdraftLimit; }
-    void setOverdraftLimit(double limit) { overdraftLimit = limit; }
+    Money getOverdraftLimit() const { return overdraftLimit; }
+    void setOverdraftLimit(Money limit) { overdraftLimit = limit; }
 };
 
-class BusinessAccount : public Account {
+class BusinessAccount : public AccountOf<BusinessAccount, BalanceLimit, NoInterest> {
 private:
     std::string businessName;
     std::string taxId;
-    double monthlyFee;
+    Money monthlyFee;
 
 public:
     BusinessAccount(const std::string& holderName, const std::string& business, 
-                   const std::string& tax, double initialBalance = 0.0);
+                   const std::string& tax, Money initialBalance = Money());
     
     std::string getBusinessName() const { return businessName; }
     std::string getTaxId() const { return taxId; }
-    double getMonthlyFee() const { return monthlyFee; }
-    void setMonthlyFee(double fee) { monthlyFee = fee; }
-}; 
\ No newline at end of file
+    Money getMonthlyFee() const { return monthlyFee; }
+    void setMonthlyFee(Money fee) { monthlyFee = fee; }
+};
@@ -0,0 +1,52 @@
+#pragma once
+#include <chrono>
+#include "Money.h"
+
+// Compile-time rules plugged into AccountOf. Each policy is a stateless struct
+// whose static functions read the concrete account type they are handed, so
+// calls resolve and inline at compile time instead of going through a vtable.
+
+// Withdrawals limited to the current balance
+struct BalanceLimit {
+    template <typename Record>
+    static bool allows(const Record& account, Money amount) {
+        return amount <= account.getBalance();
+    }
+};
+
+// Withdrawals may overdraw the balance down to the account's overdraft limit
+struct OverdraftLimit {
+    template <typename Record>
+    static bool allows(const Record& account, Money amount) {
+        return amount <= account.getBalance() + account.getOverdraftLimit();
+    }
+};
+
+// Accounts that never earn interest
+struct NoInterest {
+    template <typename Record>
+    static Money accrued(const Record&, std::chrono::system_clock::time_point) {
+        return Money();
+    }
+    
+    template <typename Record>
+    static void credited(Record&, std::chrono::system_clock::time_point) {}
+};
+
+// Simple interest at the account's annual rate, accrued per day since it was last credited
+struct DailyInterest {
+    template <typename Record>
+    static Money accrued(const Record& account, std::chrono::system_clock::time_point now) {
+        auto duration = std::chrono::duration_cast<std::chrono::hours>(now - account.getLastInterestDate());
+        double hours = duration.count();
+        
+        double dailyRate = account.getInterestRate() / 365.0;
+        double days = hours / 24.0;
+        return account.getBalance().scaledBy(dailyRate * days);
+    }
+    
+    template <typename Record>
+    static void credited(Record& account, std::chrono::system_clock::time_point now) {
+        account.setLastInterestDate(now);
+    }
+};
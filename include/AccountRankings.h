@@ -0,0 +1,79 @@
+#pragma once
+#include <vector>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include "AccountRegistry.h"
+#include "Money.h"
+#include "RankedSet.h"
+
+// Leaderboards that Bank updates as balances change and rows are recorded.
+// Balances and today's activity counts live in ranked sets; the largest rows
+// are a bounded min-heap, since a recorded amount never changes. Every query
+// reads only the entries it returns.
+//
+// An instance may rank one shard of the accounts: the ids congruent to shard
+// modulo shardCount. They are stored densely as id / shardCount and handed
+// back as the original ids. Since each shard keeps its own top entries, the
+// overall top k is the top k of the shards' results taken together.
+class AccountRankings {
+public:
+    static constexpr std::size_t MAX_TRACKED_TRANSACTIONS = 64;
+    
+    struct RankedTransaction {
+        Money amount;
+        std::size_t row;
+    };
+
+private:
+    AccountId shard;
+    AccountId shardCount;
+    RankedSet<Money> balances;
+    RankedSet<std::uint32_t> activityToday;
+    std::chrono::system_clock::time_point dayEnd;
+    std::vector<RankedTransaction> largestRows;     // min-heap on amount
+
+public:
+    explicit AccountRankings(AccountId shard = 0, AccountId shardCount = 1) : shard(shard), shardCount(shardCount) {}
+    
+    // Updates; a row counts once towards each account it touches, while its
+    // amount is tracked by whichever shard the caller picks for the row
+    void balanceChanged(AccountId accountId, Money balance) { balances.assign(localId(accountId), balance); }
+    void accountClosed(AccountId accountId) { balances.erase(localId(accountId)); }
+    void activityRecorded(AccountId accountId, std::chrono::system_clock::time_point timestamp);
+    void rowRecorded(std::size_t row, Money amount) { trackRow(RankedTransaction{amount, row}); }
+    void clearTransactions();
+    
+    // Ledger compaction: tracked rows move to newRowOf[row], or leave where it holds
+    // dropped; each folded credit leaves today's counts and each summary joins them
+    void rowsRenumbered(const std::vector<std::uint32_t>& newRowOf, std::uint32_t dropped);
+    void creditFolded(AccountId accountId, std::chrono::system_clock::time_point timestamp);
+    void summaryAdded(std::size_t row, Money amount, AccountId accountId,
+                      std::chrono::system_clock::time_point timestamp);
+    void clear();
+    
+    // Queries
+    std::vector<std::pair<Money, AccountId>> largestBalances(std::size_t limit) const;
+    std::vector<std::pair<std::uint32_t, AccountId>> mostActiveToday(std::size_t limit,
+                                                                     std::chrono::system_clock::time_point now) const;
+    std::vector<RankedTransaction> largestTransactions(std::size_t limit) const;
+    
+    // Orders entries the way the queries return them: highest first, ties by lower id or row
+    template <typename Score>
+    static bool ranksBefore(const std::pair<Score, AccountId>& a, const std::pair<Score, AccountId>& b) {
+        return a.first != b.first ? b.first < a.first : a.second < b.second;
+    }
+    static bool ranksBefore(const RankedTransaction& a, const RankedTransaction& b) {
+        return a.amount != b.amount ? b.amount < a.amount : a.row < b.row;
+    }
+
+private:
+    AccountId localId(AccountId accountId) const { return accountId / shardCount; }
+    AccountId globalId(AccountId localId) const { return localId * shardCount + shard; }
+    template <typename Score>
+    std::vector<std::pair<Score, AccountId>> toGlobal(std::vector<std::pair<Score, AccountId>> entries) const;
+    void countActivity(AccountId accountId);
+    void trackRow(const RankedTransaction& entry);
+    bool countedToday(std::chrono::system_clock::time_point timestamp) const;
+    static std::chrono::system_clock::time_point nextMidnight(std::chrono::system_clock::time_point time);
+};
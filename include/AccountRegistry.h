@@ -0,0 +1,55 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include "HashIndex.h"
+#include "SlotMap.h"
+
+// Dense integer key for an account. Ids are handed out in creation order and
+// never reused, so they can index plain vectors and be stored in transaction
+// rows in place of the printable account number.
+using AccountId = std::uint32_t;
+constexpr AccountId INVALID_ACCOUNT_ID = static_cast<AccountId>(-1);
+
+enum class AccountType {
+    SAVINGS,
+    CHECKING,
+    BUSINESS
+};
+
+// Generational reference to a live account held by Bank: the per-type table
+// the account lives in plus a slot in that table. Unlike an AccountId it
+// stops resolving once the account object is removed.
+class Account;
+struct AccountHandle {
+    AccountType type = AccountType::SAVINGS;
+    SlotHandle<Account> slot;
+    bool archived = false;
+    
+    bool isNull() const { return slot.isNull(); }
+    bool operator==(const AccountHandle& other) const {
+        return type == other.type && slot == other.slot && archived == other.archived;
+    }
+    bool operator!=(const AccountHandle& other) const { return !(*this == other); }
+};
+
+// Interns account numbers into AccountIds and maps them back for display.
+class AccountRegistry {
+private:
+    std::vector<std::string> accountNumbers;
+    HashIndex<AccountId> idsByNumber;
+
+public:
+    AccountRegistry() = default;
+    
+    // Interning
+    AccountId intern(const std::string& accountNumber);
+    AccountId find(const std::string& accountNumber) const;
+    bool contains(AccountId id) const { return id < accountNumbers.size(); }
+    
+    // Display
+    const std::string& numberOf(AccountId id) const;
+    
+    std::size_t size() const { return accountNumbers.size(); }
+};
@@ -3,23 +3,91 @@
 #include <memory>
 #include <unordered_map>
 #include <string>
+#include <chrono>
+#include <array>
+#include <mutex>
+#include <shared_mutex>
+#include <utility>
 #include "User.h"
 #include "Account.h"
-#include "Transaction.h"
+#include "TransactionLedger.h"
+#include "AccountRegistry.h"
+#include "BankStatistics.h"
+#include "AccountRankings.h"
+#include "TimeSeriesRollup.h"
+#include "HashIndex.h"
+#include "PrefixTrie.h"
+#include "TrigramIndex.h"
+#include "SlotMap.h"
 
+// Concurrency: deposit, withdraw, transfer and processTransaction may be called
+// from any number of threads. Each holds structureMutex shared and locks the
+// balance stripes of the accounts it reads or writes in stripe order.
+// Statistics, rankings and rollups are sharded by stripe and updated under
+// those locks, so ledgerMutex is held only to append the row itself.
+// Statistics, ranking and chart queries lock every stripe in order and merge the
+// shards. Operations that create, close, move or batch-update accounts hold
+// structureMutex exclusively. User management and the queries that return
+// pointers, views or references are not synchronized; call them from the
+// thread that drives the UI, or while no operations are in flight.
 class Bank {
+public:
+    using AccountNumberCursor = PrefixTrie<AccountId>::Cursor;
+    
+    struct CompactionReport {
+        std::size_t accountsArchived = 0;
+        std::size_t interestRowsFolded = 0;
+        std::size_t interestSummaries = 0;
+    };
+
 private:
     std::string bankName;
     std::string bankCode;
-    std::vector<std::shared_ptr<User>> users;
-    std::vector<std::shared_ptr<Account>> accounts;
-    std::vector<std::shared_ptr<Transaction>> allTransactions;
-    std::shared_ptr<User> currentUser;
+    SlotMap<std::unique_ptr<User>, User> users;
+    HashIndex<UserHandle> userIdIndex;
+    HashIndex<UserHandle> usernameIndex;
+    
+    // Email and phone may be shared, e.g. a household phone, so each key lists its users
+    HashIndex<std::vector<UserHandle>> emailIndex;
+    HashIndex<std::vector<UserHandle>> phoneIndex;
+    AccountRegistry accountRegistry;
+    
+    // One contiguous table per account type, so batch work runs on a single concrete type
+    SlotMap<SavingsAccount, Account> savingsAccounts;
+    SlotMap<CheckingAccount, Account> checkingAccounts;
+    SlotMap<BusinessAccount, Account> businessAccounts;
+    
+    // Deactivated accounts moved out of the live tables by compact()
+    SlotMap<SavingsAccount, Account> archivedSavings;
+    SlotMap<CheckingAccount, Account> archivedChecking;
+    SlotMap<BusinessAccount, Account> archivedBusiness;
+    std::vector<AccountHandle> accountHandles;          // indexed by AccountId
+    std::vector<UserHandle> accountOwners;              // indexed by AccountId
+    
+    PrefixTrie<AccountId> holderNameIndex;
+    PrefixTrie<AccountId> accountNumberIndex;
     
-    // Statistics
-    double totalAssets;
-    int totalAccounts;
-    int totalUsers;
+    // Fuzzy search; users are keyed by slot index, accounts by AccountId
+    TrigramIndex<UserHandle> userSearchIndex;
+    TrigramIndex<AccountId> accountSearchIndex;
+    TransactionLedger allTransactions;
+    UserHandle currentUser;
+    
+    // Balances are guarded by a stripe chosen from the AccountId. Each stripe
+    // also holds the statistics, rankings and rollups of its accounts, updated
+    // under its lock, and starts on its own cache line so disjoint accounts do
+    // not contend. A row's amount is counted on the stripe of its first valid
+    // account, or on stripe 0 when it has none
+    static constexpr std::size_t BALANCE_STRIPES = 64;
+    struct alignas(64) BalanceStripe {
+        std::mutex mutex;
+        BankStatistics statistics;
+        AccountRankings rankings;
+        TimeSeriesRollup rollups;
+    };
+    mutable std::shared_mutex structureMutex;
+    mutable std::array<BalanceStripe, BALANCE_STRIPES> balanceStripes;
+    std::mutex ledgerMutex;
     
     // File paths for persistence
     std::string usersFile;
@@ -40,55 +108,134 @@ public:
                      UserRole role = UserRole::CUSTOMER);
     bool authenticateUser(const std::string& username, const std::string& password);
     void logoutUser();
-    std::shared_ptr<User> getCurrentUser() const { return currentUser; }
+    User* getCurrentUser() const { return getUser(currentUser); }
+    User* getUser(UserHandle user) const;
     
     // Account management
-    std::shared_ptr<Account> createAccount(const std::string& holderName, 
-                                         AccountType type, double initialBalance = 0.0);
-    std::shared_ptr<Account> createBusinessAccount(const std::string& holderName,
+    Account* createAccount(const std::string& holderName, 
+                                         AccountType type, Money initialBalance = Money());
+    Account* createBusinessAccount(const std::string& holderName,
                                                   const std::string& businessName,
                                                   const std::string& taxId,
-                                                  double initialBalance = 0.0);
-    std::shared_ptr<Account> getAccount(const std::string& accountNumber) const;
-    std::vector<std::shared_ptr<Account>> getAllAccounts() const;
+                                                  Money initialBalance = Money());
+    Account* getAccount(const std::string& accountNumber);
+    Account* getAccount(AccountId accountId);
+    Account* getAccount(AccountHandle account);
+    AccountHandle getAccountHandle(AccountId accountId) const;
+    
+    // Ownership goes through Bank so compact() can find the owner of a moved account;
+    // an account has at most one owner
+    bool assignAccount(UserHandle owner, AccountId accountId);
+    AccountId findAccountId(const std::string& accountNumber) const { return accountRegistry.find(accountNumber); }
+    const std::string& getAccountNumber(AccountId accountId) const { return accountRegistry.numberOf(accountId); }
+    std::vector<Account*> getUserAccounts(const User& user);
+    std::vector<Account*> getAccounts(AccountId first, std::size_t limit);
+    std::size_t getAccountCount() const;
+    std::size_t getArchivedAccountCount() const;
+    AccountNumberCursor accountNumberCursor() const { return AccountNumberCursor(accountNumberIndex); }
     
     // Transaction management
     bool processTransaction(const std::string& fromAccount, const std::string& toAccount,
-                          double amount, TransactionType type, const std::string& description = "");
-    std::vector<std::shared_ptr<Transaction>> getTransactionHistory(const std::string& accountNumber) const;
-    std::vector<std::shared_ptr<Transaction>> getAllTransactions() const;
+                          Money amount, TransactionType type, const std::string& description = "");
+    bool processTransaction(AccountId fromAccount, AccountId toAccount,
+                          Money amount, TransactionType type, const std::string& description = "");
+    LedgerView getTransactionHistory(const std::string& accountNumber) const;
+    LedgerView getTransactionHistory(AccountId accountId) const;
+    const AccountActivity& getAccountActivity(AccountId accountId) const { return allTransactions.activityOf(accountId); }
+    const TransactionLedger& getAllTransactions() const { return allTransactions; }
     
     // Banking operations
-    bool deposit(const std::string& accountNumber, double amount);
-    bool withdraw(const std::string& accountNumber, double amount);
-    bool transfer(const std::string& fromAccount, const std::string& toAccount, double amount);
-    
-    // Statistics and reporting
-    double getTotalAssets() const { return totalAssets; }
-    int getTotalAccounts() const { return totalAccounts; }
-    int getTotalUsers() const { return totalUsers; }
+    bool deposit(const std::string& accountNumber, Money amount);
+    bool withdraw(const std::string& accountNumber, Money amount);
+    bool transfer(const std::string& fromAccount, const std::string& toAccount, Money amount,
+                  const std::string& description = "");
+    bool deposit(AccountId accountId, Money amount);
+    bool withdraw(AccountId accountId, Money amount);
+    bool transfer(AccountId fromAccount, AccountId toAccount, Money amount,
+                  const std::string& description = "");
+    
+    // Statistics and reporting, merged from the stripe shards on each call
+    Money getTotalAssets() const;
+    int getTotalAccounts() const;
+    int getTotalUsers() const { return static_cast<int>(users.size()); }
+    BankStatistics getStatistics() const;
+    std::vector<std::pair<Money, AccountId>> getLargestBalances(std::size_t limit) const;
+    std::vector<std::pair<std::uint32_t, AccountId>> getMostActiveToday(std::size_t limit,
+                                                                        std::chrono::system_clock::time_point now) const;
+    std::vector<AccountRankings::RankedTransaction> getLargestTransactions(std::size_t limit) const;
+    std::vector<TimeSeriesRollup::Point> getAssetChart(std::chrono::system_clock::time_point from,
+                                                       std::chrono::system_clock::time_point to,
+                                                       std::size_t maxPoints) const;
     void updateStatistics();
     
     // Search and query
-    std::shared_ptr<User> findUser(const std::string& username) const;
-    std::vector<std::shared_ptr<Account>> findAccountsByHolder(const std::string& holderName) const;
-    std::vector<std::shared_ptr<Transaction>> findTransactionsByDate(const std::string& accountNumber,
-                                                                    const std::string& startDate,
-                                                                    const std::string& endDate) const;
+    User* findUser(const std::string& username) const;
+    User* findUserByEmail(const std::string& email) const;
+    User* findUserByPhone(const std::string& phone) const;
+    std::vector<Account*> findAccountsByHolder(const std::string& holderName);
+    std::vector<Account*> findAccountsByHolderPrefix(const std::string& prefix,
+                                                     std::size_t limit = 50);
+    std::vector<Transaction> findTransactionsByDate(const std::string& accountNumber,
+                                                   const std::string& startDate,
+                                                   const std::string& endDate) const;
+    LedgerRange findTransactionsByDate(const std::string& startDate, const std::string& endDate) const;
+    std::vector<Transaction> findTransactions(const TransactionFilter& filter) const;
+    std::vector<UserHandle> searchUsers(const std::string& query, std::size_t limit = 10) const;
+    std::vector<AccountId> searchAccounts(const std::string& query, std::size_t limit = 10) const;
+    LedgerRange getTransactionsBetween(std::chrono::system_clock::time_point start,
+                                       std::chrono::system_clock::time_point end) const { return allTransactions.between(start, end); }
     
     // Data persistence
     bool saveData();
     bool loadData();
     
     // Admin functions
-    std::vector<std::shared_ptr<User>> getAllUsers() const;
+    Span<const std::unique_ptr<User>> getUsers(std::size_t offset, std::size_t limit) const { return users.view().page(offset, limit); }
+    std::size_t getUserCount() const { return users.size(); }
     bool deleteUser(const std::string& userId);
+    bool deleteUser(UserHandle user);
     bool deleteAccount(const std::string& accountNumber);
     void applyInterestToAllSavings();
     
+    // Explicit maintenance: archives closed accounts and folds interest older than the
+    // cutoff. The ledger is rebuilt, so row numbers, views and ranges taken earlier are invalid
+    CompactionReport compact(std::chrono::system_clock::time_point interestCutoff);
+    
 private:
     void initializeBank();
+    template <typename T>
+    Account* storeAccount(SlotMap<T, Account>& table, T account);
+    template <typename Visitor>
+    void forEachAccountTable(Visitor&& visit);
+    template <typename Visitor>
+    void forEachTablePair(Visitor&& visit);
+    std::size_t archiveInactiveAccounts();
+    void reindexUserContact(const User& user, const std::string& newEmail, const std::string& newPhone);
+    void reindexUserSearch(UserHandle user, const std::string& username,
+                           const std::string& firstName, const std::string& lastName,
+                           const std::string& email, const std::string& phone);
     std::string generateBankCode();
-    void updateAccountStatistics();
-    void updateUserStatistics();
+    
+    // Balance operations; the caller holds structureMutex (shared or exclusive)
+    bool applyDeposit(AccountId accountId, Money amount);
+    bool applyWithdrawal(AccountId accountId, Money amount);
+    bool applyTransfer(AccountId fromAccount, AccountId toAccount, Money amount, const std::string& description);
+    BalanceStripe& stripeOf(AccountId accountId) { return balanceStripes[accountId % BALANCE_STRIPES]; }
+    BalanceStripe& rowStripeOf(AccountId fromAccount, AccountId toAccount);
+    using BalanceLocks = std::pair<std::unique_lock<std::mutex>, std::unique_lock<std::mutex>>;
+    BalanceLocks lockBalances(AccountId first, AccountId second);
+    template <typename Reader>
+    auto readStripes(Reader&& read) const;
+    
+    // Bookkeeping; the caller holds the stripes of the accounts involved (see
+    // lockBalances) or structureMutex exclusively. recordTransaction takes
+    // ledgerMutex for the append and returns the row's timestamp
+    void recordBalanceChange(const Account& account, Money before, std::chrono::system_clock::time_point time);
+    std::chrono::system_clock::time_point recordTransaction(AccountId fromAccount, AccountId toAccount, Money amount,
+                                                            TransactionType type, const std::string& description = "");
+    static std::string normalizeHolderName(const std::string& name);
+    static bool parseDate(const std::string& text, bool endOfRange, std::chrono::system_clock::time_point& result);
+    std::vector<Account*> resolveAccounts(const std::vector<AccountId>& accountIds);
+    User* findIndexedUser(const HashIndex<UserHandle>& index, const std::string& key) const;
+    User* findContactUser(const HashIndex<std::vector<UserHandle>>& index, const std::string& key) const;
 }; 
\ No newline at end of file
@@ -0,0 +1,56 @@
+#pragma once
+#include <cstddef>
+#include "AccountRegistry.h"
+#include "Money.h"
+#include "QuantileSketch.h"
+
+// Running aggregates over every account, kept current from balance deltas.
+// Bank reports each change as it happens, so reading any figure is O(1) and
+// no operation ever rescans the account tables. Assets count active accounts
+// only; the overdrawn count covers every checking account below zero. The
+// balance distribution of active accounts is sketched for percentiles.
+// Partial aggregates over disjoint sets of accounts combine with merge(), so
+// Bank can keep one per balance stripe and sum them when asked.
+class BankStatistics {
+public:
+    static constexpr std::size_t ACCOUNT_TYPE_COUNT = 3;
+
+private:
+    struct TypeTotals {
+        Money activeBalance;
+        std::size_t activeCount = 0;
+        std::size_t inactiveCount = 0;
+    };
+    
+    TypeTotals byType[ACCOUNT_TYPE_COUNT];
+    Money totalAssets;
+    std::size_t overdrawnChecking;
+    QuantileSketch balanceDistribution;
+
+public:
+    BankStatistics() : overdrawnChecking(0) {}
+    
+    // Updates
+    void accountAdded(AccountType type, Money balance, bool active);
+    void balanceChanged(AccountType type, bool active, Money before, Money after);
+    void activationChanged(AccountType type, Money balance, bool nowActive);
+    void merge(const BankStatistics& other);
+    void clear();
+    
+    // Queries
+    Money getTotalAssets() const { return totalAssets; }
+    Money getTotalBalance(AccountType type) const { return totals(type).activeBalance; }
+    std::size_t getActiveCount(AccountType type) const { return totals(type).activeCount; }
+    std::size_t getInactiveCount(AccountType type) const { return totals(type).inactiveCount; }
+    std::size_t getAccountCount(AccountType type) const { return getActiveCount(type) + getInactiveCount(type); }
+    std::size_t getActiveCount() const;
+    std::size_t getInactiveCount() const;
+    std::size_t getAccountCount() const { return getActiveCount() + getInactiveCount(); }
+    std::size_t getOverdrawnCheckingCount() const { return overdrawnChecking; }
+    Money getBalancePercentile(double q) const { return balanceDistribution.quantile(q); }
+    const QuantileSketch& getBalanceDistribution() const { return balanceDistribution; }
+
+private:
+    TypeTotals& totals(AccountType type) { return byType[static_cast<std::size_t>(type)]; }
+    const TypeTotals& totals(AccountType type) const { return byType[static_cast<std::size_t>(type)]; }
+};
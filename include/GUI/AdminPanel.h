@@ -1,6 +1,8 @@
 #pragma once
 #include "Screen.h"
+#include "User.h"
 #include <memory>
+#include <vector>
 
 class Bank;
 class TextField;
@@ -15,11 +17,15 @@ private:
     std::shared_ptr<Button> createAccountButton;
     std::shared_ptr<Button> backButton;
     std::shared_ptr<Button> refreshButton;
+    std::shared_ptr<Button> compactButton;
     
     std::string searchQuery;
+    std::vector<UserHandle> userResults;
+    std::vector<AccountId> accountResults;
     std::string message;
-    bool showMessage;
+    bool messageVisible;
     int messageTimer;
+    bool compactArmed;      // the first Compact click only asks for confirmation
 
 public:
     AdminPanel(std::shared_ptr<Window> window, std::shared_ptr<Bank> bankSystem);
@@ -39,10 +45,17 @@ private:
     void handleCreateAccount();
     void handleBack();
     void handleRefresh();
+    void handleCompact();
     void showMessage(const std::string& msg);
     void clearMessage();
     void renderMessage();
     void renderSystemStats();
     void renderUserList();
     void renderAccountList();
+    void renderRankings();
+    void renderActivityChart();
+    
+    // Right-hand column for percentiles, rankings and the chart, sized from the window
+    int sideColumnLeft() const;
+    int sideColumnRight() const;
 }; 
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 #include "Screen.h"
+#include "AccountRegistry.h"
 #include <memory>
 #include <vector>
 
@@ -18,9 +19,9 @@ private:
     std::shared_ptr<Button> logoutButton;
     std::shared_ptr<Button> adminButton;
     
-    // Account display
-    std::vector<std::shared_ptr<Account>> userAccounts;
-    std::shared_ptr<Account> selectedAccount;
+    // Account display; ids are resolved through the bank on each use, since
+    // account tables move their contents as accounts are added or archived
+    std::vector<AccountId> userAccounts;
     int selectedAccountIndex;
     
     // UI elements
@@ -76,6 +77,7 @@ private:
     void renderUserInfo();
     
     // Utility
+    Account* getSelectedAccount() const;
     void selectAccount(int index);
     void refreshData();
 }; 
\ No newline at end of file
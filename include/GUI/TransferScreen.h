@@ -1,8 +1,9 @@
 #pragma once
 #include "Screen.h"
+#include "Bank.h"
 #include <memory>
+#include <vector>
 
-class Bank;
 class TextField;
 class Button;
 
@@ -17,6 +18,10 @@ private:
     std::shared_ptr<Button> backButton;
     std::shared_ptr<Button> clearButton;
     
+    // Destination account autocomplete
+    Bank::AccountNumberCursor accountCursor;
+    std::vector<std::string> accountSuggestions;
+    
     std::string errorMessage;
     std::string successMessage;
     bool showError;
@@ -43,5 +48,8 @@ private:
     void showSuccessMessage(const std::string& message);
     void clearMessages();
     void renderMessages();
+    void updateAccountSuggestions(const std::string& text);
+    void renderAccountSuggestions();
+    bool handleSuggestionClick(int mouseX, int mouseY);
     bool validateInput();
 }; 
\ No newline at end of file
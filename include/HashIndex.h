@@ -0,0 +1,192 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <functional>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+// Open-addressing hash table keyed on strings.
+// Uses linear probing over a power-of-two table and tombstones for deletes,
+// so lookups stay O(1) on average regardless of how many entries it holds.
+template <typename Value>
+class HashIndex {
+private:
+    enum class SlotState : std::uint8_t {
+        EMPTY,
+        OCCUPIED,
+        DELETED
+    };
+    
+    struct Slot {
+        std::size_t hash = 0;
+        std::string key;
+        Value value{};
+        SlotState state = SlotState::EMPTY;
+    };
+    
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+    static constexpr std::size_t minCapacity = 16;
+    
+    std::vector<Slot> slots;
+    std::size_t count;
+    std::size_t tombstones;
+
+public:
+    HashIndex() : count(0), tombstones(0) {}
+    
+    // Lookup
+    const Value* find(const std::string& key) const;
+    Value* find(const std::string& key);
+    bool contains(const std::string& key) const { return find(key) != nullptr; }
+    
+    // Modification
+    bool insert(const std::string& key, const Value& value);
+    void insertOrAssign(const std::string& key, const Value& value);
+    bool erase(const std::string& key);
+    void clear();
+    void reserve(std::size_t expectedEntries);
+    
+    // Capacity
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+private:
+    std::size_t locate(const std::string& key, std::size_t hash) const;
+    std::size_t insertSlot(std::string key, std::size_t hash);
+    void growIfNeeded();
+    void rehash(std::size_t newCapacity);
+    static std::size_t hashKey(const std::string& key) { return std::hash<std::string>()(key); }
+};
+
+template <typename Value>
+const Value* HashIndex<Value>::find(const std::string& key) const {
+    std::size_t index = locate(key, hashKey(key));
+    return index == npos ? nullptr : &slots[index].value;
+}
+
+template <typename Value>
+Value* HashIndex<Value>::find(const std::string& key) {
+    std::size_t index = locate(key, hashKey(key));
+    return index == npos ? nullptr : &slots[index].value;
+}
+
+template <typename Value>
+bool HashIndex<Value>::insert(const std::string& key, const Value& value) {
+    std::size_t hash = hashKey(key);
+    if (locate(key, hash) != npos) {
+        return false;
+    }
+    
+    growIfNeeded();
+    std::size_t index = insertSlot(key, hash);
+    slots[index].value = value;
+    return true;
+}
+
+template <typename Value>
+void HashIndex<Value>::insertOrAssign(const std::string& key, const Value& value) {
+    std::size_t hash = hashKey(key);
+    std::size_t index = locate(key, hash);
+    if (index == npos) {
+        growIfNeeded();
+        index = insertSlot(key, hash);
+    }
+    slots[index].value = value;
+}
+
+template <typename Value>
+bool HashIndex<Value>::erase(const std::string& key) {
+    std::size_t index = locate(key, hashKey(key));
+    if (index == npos) {
+        return false;
+    }
+    
+    Slot& slot = slots[index];
+    slot.state = SlotState::DELETED;
+    slot.key.clear();
+    slot.value = Value{};
+    --count;
+    ++tombstones;
+    return true;
+}
+
+template <typename Value>
+void HashIndex<Value>::clear() {
+    slots.clear();
+    count = 0;
+    tombstones = 0;
+}
+
+template <typename Value>
+void HashIndex<Value>::reserve(std::size_t expectedEntries) {
+    std::size_t capacity = minCapacity;
+    while (capacity * 3 < expectedEntries * 4) {
+        capacity *= 2;
+    }
+    if (capacity > slots.size()) {
+        rehash(capacity);
+    }
+}
+
+template <typename Value>
+std::size_t HashIndex<Value>::locate(const std::string& key, std::size_t hash) const {
+    if (slots.empty()) {
+        return npos;
+    }
+    
+    std::size_t mask = slots.size() - 1;
+    for (std::size_t index = hash & mask;; index = (index + 1) & mask) {
+        const Slot& slot = slots[index];
+        if (slot.state == SlotState::EMPTY) {
+            return npos;
+        }
+        if (slot.state == SlotState::OCCUPIED && slot.hash == hash && slot.key == key) {
+            return index;
+        }
+    }
+}
+
+template <typename Value>
+std::size_t HashIndex<Value>::insertSlot(std::string key, std::size_t hash) {
+    std::size_t mask = slots.size() - 1;
+    std::size_t index = hash & mask;
+    while (slots[index].state == SlotState::OCCUPIED) {
+        index = (index + 1) & mask;
+    }
+    
+    Slot& slot = slots[index];
+    if (slot.state == SlotState::DELETED) {
+        --tombstones;
+    }
+    slot.hash = hash;
+    slot.key = std::move(key);
+    slot.state = SlotState::OCCUPIED;
+    ++count;
+    return index;
+}
+
+template <typename Value>
+void HashIndex<Value>::growIfNeeded() {
+    // Keep live entries plus tombstones under a 75% load factor
+    if (slots.empty()) {
+        rehash(minCapacity);
+    } else if ((count + tombstones + 1) * 4 > slots.size() * 3) {
+        rehash(count * 2 >= slots.size() ? slots.size() * 2 : slots.size());
+    }
+}
+
+template <typename Value>
+void HashIndex<Value>::rehash(std::size_t newCapacity) {
+    std::vector<Slot> oldSlots(newCapacity);
+    oldSlots.swap(slots);
+    count = 0;
+    tombstones = 0;
+    
+    for (auto& slot : oldSlots) {
+        if (slot.state == SlotState::OCCUPIED) {
+            std::size_t index = insertSlot(std::move(slot.key), slot.hash);
+            slots[index].value = std::move(slot.value);
+        }
+    }
+}
@@ -0,0 +1,25 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// Distinct-count estimate in a fixed 256 bytes.
+// Each value is hashed; the top bits pick one of 2^PRECISION registers, which
+// keeps the longest run of leading zeros seen in the remaining bits. The
+// standard error is about 1.04 / sqrt(256), roughly 6.5%, with small counts
+// corrected by linear counting. Two sketches merge by taking register maxima.
+class HyperLogLog {
+public:
+    static constexpr unsigned PRECISION = 8;
+    static constexpr std::size_t REGISTER_COUNT = std::size_t(1) << PRECISION;
+
+private:
+    std::uint8_t registers[REGISTER_COUNT] = {};
+
+public:
+    void add(std::uint64_t value);
+    void merge(const HyperLogLog& other);
+    std::uint64_t estimate() const;
+
+private:
+    static std::uint64_t mix(std::uint64_t value);
+};
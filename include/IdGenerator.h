@@ -0,0 +1,30 @@
+#pragma once
+#include <string>
+#include <cstddef>
+#include <cstdint>
+
+enum class IdSpace : std::uint8_t {
+    TRANSACTION,
+    ACCOUNT,
+    USER
+};
+
+// Monotonic sequence numbers for transaction ids, account numbers and user ids.
+// Each space has one shared atomic counter; threads reserve blocks of values
+// from it and hand them out locally, so an id costs an increment and a few
+// digit stores. Ids are unique within a process by construction.
+class IdGenerator {
+public:
+    static constexpr std::uint64_t blockSize = 1024;
+    
+    // Next sequence number in a space
+    static std::uint64_t next(IdSpace space);
+    
+    // Writes prefix followed by value zero-padded to width digits; returns the length
+    static std::size_t format(char* buffer, const char* prefix, std::uint64_t value, std::size_t width);
+    
+    // Formatted ids; all fit std::string's inline storage
+    static std::string nextTransactionId();
+    static std::string nextAccountNumber(const std::string& prefix);
+    static std::string nextUserId();
+};
@@ -0,0 +1,51 @@
+#pragma once
+#include <string>
+#include <cstdint>
+
+// Exact currency amount stored as a signed 64-bit count of cents.
+// All arithmetic is integer arithmetic, so running totals never drift, and a
+// column of Money is a plain array of int64 that MoneyKernels can vectorize.
+class Money {
+private:
+    std::int64_t cents;
+    
+    constexpr explicit Money(std::int64_t value) : cents(value) {}
+
+public:
+    constexpr Money() : cents(0) {}
+    
+    // Construction
+    static constexpr Money fromCents(std::int64_t value) { return Money(value); }
+    static constexpr Money fromDollars(std::int64_t dollars) { return Money(dollars * 100); }
+    static Money fromDouble(double amount);
+    static bool parse(const std::string& text, Money& result);
+    
+    // Access
+    constexpr std::int64_t getCents() const { return cents; }
+    constexpr std::int64_t getWholeDollars() const { return cents / 100; }
+    double toDouble() const { return static_cast<double>(cents) / 100.0; }
+    constexpr bool isPositive() const { return cents > 0; }
+    constexpr bool isNegative() const { return cents < 0; }
+    constexpr bool isZero() const { return cents == 0; }
+    
+    // Arithmetic; scaledBy rounds to the nearest cent
+    Money scaledBy(double factor) const;
+    constexpr Money operator-() const { return Money(-cents); }
+    constexpr Money operator+(Money other) const { return Money(cents + other.cents); }
+    constexpr Money operator-(Money other) const { return Money(cents - other.cents); }
+    Money& operator+=(Money other) { cents += other.cents; return *this; }
+    Money& operator-=(Money other) { cents -= other.cents; return *this; }
+    
+    // Comparison
+    constexpr bool operator==(Money other) const { return cents == other.cents; }
+    constexpr bool operator!=(Money other) const { return cents != other.cents; }
+    constexpr bool operator<(Money other) const { return cents < other.cents; }
+    constexpr bool operator<=(Money other) const { return cents <= other.cents; }
+    constexpr bool operator>(Money other) const { return cents > other.cents; }
+    constexpr bool operator>=(Money other) const { return cents >= other.cents; }
+    
+    // Display, e.g. "$1234.56" or "-$5.00"
+    std::string toString() const;
+};
+
+static_assert(sizeof(Money) == sizeof(std::int64_t), "Money columns must stay plain int64 arrays");
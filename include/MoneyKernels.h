@@ -0,0 +1,51 @@
+#pragma once
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include "Money.h"
+
+// Aggregation kernels over contiguous Money columns (ledger amounts, balances).
+// Loops are branch-free and keep several independent accumulators so the
+// compiler can turn them into packed 64-bit integer SIMD; results are exact.
+class MoneyKernels {
+public:
+    static Money sum(const Money* values, std::size_t count);
+    static Money min(const Money* values, std::size_t count);
+    static Money max(const Money* values, std::size_t count);
+    
+    // Indices of values in [low, high], in ascending order
+    static std::vector<std::uint32_t> selectBetween(const Money* values, std::size_t count, Money low, Money high);
+    
+    // Sum of values whose key column matches, over all rows or a row list
+    template <typename Key>
+    static Money sumWhere(const Money* values, const Key* keys, Key key, std::size_t count);
+    template <typename Key>
+    static Money sumWhere(const Money* values, const Key* keys, Key key, const std::uint32_t* rows, std::size_t rowCount);
+};
+
+template <typename Key>
+Money MoneyKernels::sumWhere(const Money* values, const Key* keys, Key key, std::size_t count) {
+    // Select with a mask instead of a branch so mismatches cost nothing extra
+    std::int64_t totals[4] = {0, 0, 0, 0};
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        for (std::size_t lane = 0; lane < 4; ++lane) {
+            std::int64_t mask = -static_cast<std::int64_t>(keys[i + lane] == key);
+            totals[lane] += values[i + lane].getCents() & mask;
+        }
+    }
+    for (; i < count; ++i) {
+        totals[0] += values[i].getCents() & -static_cast<std::int64_t>(keys[i] == key);
+    }
+    return Money::fromCents(totals[0] + totals[1] + totals[2] + totals[3]);
+}
+
+template <typename Key>
+Money MoneyKernels::sumWhere(const Money* values, const Key* keys, Key key, const std::uint32_t* rows, std::size_t rowCount) {
+    std::int64_t total = 0;
+    for (std::size_t i = 0; i < rowCount; ++i) {
+        std::uint32_t row = rows[i];
+        total += values[row].getCents() & -static_cast<std::int64_t>(keys[row] == key);
+    }
+    return Money::fromCents(total);
+}
@@ -0,0 +1,318 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <algorithm>
+
+// Character trie mapping string keys to one or more values.
+// Nodes live in a flat vector and link to their children through a sorted
+// first-child/next-sibling chain, so a node costs 16 bytes and prefix queries
+// walk only the matching subtree. Erasing a key's last value prunes the nodes
+// that no longer lead to any value and recycles them. Node ids are stable
+// until the version changes, which lets callers resume a search from a
+// previously found node.
+template <typename Value>
+class PrefixTrie {
+public:
+    using NodeId = std::uint32_t;
+    static constexpr NodeId npos = static_cast<NodeId>(-1);
+    
+    // Incremental prefix search. Each update reuses the nodes matched for the
+    // previous text up to the common prefix, so typing or deleting a character
+    // costs a single child lookup instead of a walk from the root.
+    class Cursor {
+    private:
+        const PrefixTrie* trie;
+        std::string text;
+        std::vector<NodeId> path;
+        std::uint64_t version;
+
+    public:
+        Cursor() : trie(nullptr), version(0) {}
+        explicit Cursor(const PrefixTrie& source) : trie(&source), path(1, 0), version(source.getVersion()) {}
+        
+        NodeId update(const std::string& prefix);
+        NodeId node() const { return path.empty() ? npos : path.back(); }
+        bool hasMatches() const { return node() != npos; }
+        const std::string& getText() const { return text; }
+        std::vector<Value> suggestions(std::size_t limit) const;
+        template <typename Predicate>
+        std::vector<Value> suggestions(std::size_t limit, Predicate keep) const {
+            return trie ? trie->collect(node(), limit, keep) : std::vector<Value>();
+        }
+    };
+
+private:
+    struct Node {
+        NodeId firstChild = npos;
+        NodeId nextSibling = npos;
+        std::uint32_t firstValue = npos;
+        char label = '\0';
+    };
+    
+    struct ValueEntry {
+        Value value;
+        std::uint32_t next;
+    };
+    
+    std::vector<Node> nodes;
+    std::vector<ValueEntry> values;
+    NodeId freeNodes;                   // linked through nextSibling
+    std::uint32_t freeValues;
+    std::size_t valueCount;
+    std::uint64_t version;
+
+public:
+    PrefixTrie() : nodes(1), freeNodes(npos), freeValues(npos), valueCount(0), version(0) {}
+    
+    // Modification
+    void insert(const std::string& key, const Value& value);
+    bool erase(const std::string& key, const Value& value);
+    void clear();
+    
+    // Navigation
+    NodeId root() const { return 0; }
+    NodeId child(NodeId node, char label) const;
+    NodeId find(const std::string& prefix, NodeId from = 0) const;
+    
+    // Queries
+    std::vector<Value> exact(const std::string& key) const;
+    std::vector<Value> collect(NodeId node, std::size_t limit) const;
+    template <typename Predicate>
+    std::vector<Value> collect(NodeId node, std::size_t limit, Predicate keep) const;
+    std::vector<Value> withPrefix(const std::string& prefix, std::size_t limit) const;
+    
+    // Size and change tracking
+    std::size_t size() const { return valueCount; }
+    bool empty() const { return valueCount == 0; }
+    std::uint64_t getVersion() const { return version; }
+
+private:
+    NodeId childOrInsert(NodeId node, char label);
+    void prune(std::vector<NodeId>& path);
+};
+
+template <typename Value>
+void PrefixTrie<Value>::insert(const std::string& key, const Value& value) {
+    NodeId node = root();
+    for (char c : key) {
+        node = childOrInsert(node, c);
+    }
+    
+    std::uint32_t entry;
+    if (freeValues != npos) {
+        entry = freeValues;
+        freeValues = values[entry].next;
+        values[entry].value = value;
+    } else {
+        entry = static_cast<std::uint32_t>(values.size());
+        values.push_back({value, npos});
+    }
+    values[entry].next = nodes[node].firstValue;
+    nodes[node].firstValue = entry;
+    ++valueCount;
+    ++version;
+}
+
+template <typename Value>
+bool PrefixTrie<Value>::erase(const std::string& key, const Value& value) {
+    std::vector<NodeId> path(1, root());
+    for (char c : key) {
+        NodeId next = child(path.back(), c);
+        if (next == npos) {
+            return false;
+        }
+        path.push_back(next);
+    }
+    
+    std::uint32_t* link = &nodes[path.back()].firstValue;
+    while (*link != npos) {
+        std::uint32_t entry = *link;
+        if (values[entry].value == value) {
+            *link = values[entry].next;
+            values[entry].value = Value{};
+            values[entry].next = freeValues;
+            freeValues = entry;
+            --valueCount;
+            ++version;
+            prune(path);
+            return true;
+        }
+        link = &values[entry].next;
+    }
+    return false;
+}
+
+template <typename Value>
+void PrefixTrie<Value>::clear() {
+    nodes.assign(1, Node{});
+    freeNodes = npos;
+    values.clear();
+    freeValues = npos;
+    valueCount = 0;
+    ++version;
+}
+
+template <typename Value>
+typename PrefixTrie<Value>::NodeId PrefixTrie<Value>::child(NodeId node, char label) const {
+    if (node == npos) {
+        return npos;
+    }
+    
+    // Siblings are kept sorted, so the scan can stop early
+    for (NodeId c = nodes[node].firstChild; c != npos; c = nodes[c].nextSibling) {
+        if (nodes[c].label == label) return c;
+        if (nodes[c].label > label) break;
+    }
+    return npos;
+}
+
+template <typename Value>
+typename PrefixTrie<Value>::NodeId PrefixTrie<Value>::find(const std::string& prefix, NodeId from) const {
+    NodeId node = from;
+    for (char c : prefix) {
+        node = child(node, c);
+        if (node == npos) break;
+    }
+    return node;
+}
+
+template <typename Value>
+std::vector<Value> PrefixTrie<Value>::exact(const std::string& key) const {
+    std::vector<Value> result;
+    NodeId node = find(key);
+    if (node != npos) {
+        for (std::uint32_t entry = nodes[node].firstValue; entry != npos; entry = values[entry].next) {
+            result.push_back(values[entry].value);
+        }
+    }
+    return result;
+}
+
+template <typename Value>
+std::vector<Value> PrefixTrie<Value>::collect(NodeId node, std::size_t limit) const {
+    return collect(node, limit, [](const Value&) { return true; });
+}
+
+template <typename Value>
+template <typename Predicate>
+std::vector<Value> PrefixTrie<Value>::collect(NodeId node, std::size_t limit, Predicate keep) const {
+    // Values the predicate rejects do not count towards the limit
+    std::vector<Value> result;
+    if (node == npos || limit == 0) {
+        return result;
+    }
+    
+    // Depth-first walk in key order; the subtree root's siblings are not part of it
+    std::vector<NodeId> stack;
+    stack.push_back(node);
+    while (!stack.empty()) {
+        NodeId current = stack.back();
+        stack.pop_back();
+        
+        for (std::uint32_t entry = nodes[current].firstValue; entry != npos; entry = values[entry].next) {
+            if (!keep(values[entry].value)) continue;
+            result.push_back(values[entry].value);
+            if (result.size() >= limit) return result;
+        }
+        
+        std::size_t mark = stack.size();
+        for (NodeId c = nodes[current].firstChild; c != npos; c = nodes[c].nextSibling) {
+            stack.push_back(c);
+        }
+        std::reverse(stack.begin() + mark, stack.end());
+    }
+    return result;
+}
+
+template <typename Value>
+std::vector<Value> PrefixTrie<Value>::withPrefix(const std::string& prefix, std::size_t limit) const {
+    return collect(find(prefix), limit);
+}
+
+template <typename Value>
+typename PrefixTrie<Value>::NodeId PrefixTrie<Value>::Cursor::update(const std::string& prefix) {
+    if (!trie) {
+        return npos;
+    }
+    
+    std::size_t common = 0;
+    if (version == trie->getVersion()) {
+        std::size_t limit = std::min(text.size(), prefix.size());
+        while (common < limit && text[common] == prefix[common]) {
+            ++common;
+        }
+    } else {
+        // New keys may have filled in nodes that were missing last time
+        version = trie->getVersion();
+    }
+    
+    path.resize(common + 1);
+    for (std::size_t i = common; i < prefix.size(); ++i) {
+        path.push_back(trie->child(path.back(), prefix[i]));
+    }
+    text = prefix;
+    return path.back();
+}
+
+template <typename Value>
+std::vector<Value> PrefixTrie<Value>::Cursor::suggestions(std::size_t limit) const {
+    return trie ? trie->collect(node(), limit) : std::vector<Value>();
+}
+
+template <typename Value>
+typename PrefixTrie<Value>::NodeId PrefixTrie<Value>::childOrInsert(NodeId node, char label) {
+    NodeId previous = npos;
+    NodeId c = nodes[node].firstChild;
+    while (c != npos && nodes[c].label < label) {
+        previous = c;
+        c = nodes[c].nextSibling;
+    }
+    if (c != npos && nodes[c].label == label) {
+        return c;
+    }
+    
+    Node fresh;
+    fresh.label = label;
+    fresh.nextSibling = c;
+    NodeId created;
+    if (freeNodes != npos) {
+        created = freeNodes;
+        freeNodes = nodes[created].nextSibling;
+        nodes[created] = fresh;
+    } else {
+        created = static_cast<NodeId>(nodes.size());
+        nodes.push_back(fresh);
+    }
+    if (previous == npos) {
+        nodes[node].firstChild = created;
+    } else {
+        nodes[previous].nextSibling = created;
+    }
+    return created;
+}
+
+template <typename Value>
+void PrefixTrie<Value>::prune(std::vector<NodeId>& path) {
+    // Walk up from the erased key while nodes hold neither values nor children;
+    // the root always stays
+    while (path.size() > 1) {
+        NodeId leaf = path.back();
+        if (nodes[leaf].firstValue != npos || nodes[leaf].firstChild != npos) {
+            break;
+        }
+        path.pop_back();
+        
+        NodeId* link = &nodes[path.back()].firstChild;
+        while (*link != leaf) {
+            link = &nodes[*link].nextSibling;
+        }
+        *link = nodes[leaf].nextSibling;
+        
+        nodes[leaf] = Node{};
+        nodes[leaf].nextSibling = freeNodes;
+        freeNodes = leaf;
+    }
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include "Money.h"
+
+// Streaming quantiles over money amounts with bounded relative error.
+// Values fall into logarithmic buckets whose bounds grow by a fixed ratio,
+// so any quantile is returned within 1% of a true value of the same rank.
+// Buckets only hold counts, which makes the sketch support removals (a
+// balance change is a remove plus an add) and merge by adding counts.
+// Memory grows with the range of magnitudes seen, not with the value count.
+class QuantileSketch {
+public:
+    static constexpr double RELATIVE_ACCURACY = 0.01;
+
+private:
+    std::vector<std::uint32_t> positive;    // indexed by bucket key
+    std::vector<std::uint32_t> negative;    // keyed on the magnitude
+    std::uint64_t zeroCount;
+    std::uint64_t total;
+
+public:
+    QuantileSketch() : zeroCount(0), total(0) {}
+    
+    // Updates
+    void add(Money value);
+    void remove(Money value);
+    void merge(const QuantileSketch& other);
+    void clear();
+    
+    // Queries
+    Money quantile(double q) const;
+    std::uint64_t count() const { return total; }
+    bool empty() const { return total == 0; }
+
+private:
+    static std::size_t keyOf(std::int64_t magnitude);
+    static Money valueOf(std::size_t key, bool negated);
+    static void adjust(std::vector<std::uint32_t>& buckets, std::size_t key, bool increment);
+};
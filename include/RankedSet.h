@@ -0,0 +1,85 @@
+#pragma once
+#include <set>
+#include <vector>
+#include <utility>
+#include <cstddef>
+#include <cstdint>
+
+// Scores for small dense ids, kept in descending score order.
+// Changing a score moves one tree node (re-linked, not reallocated), so an
+// update is O(log n) and reading the top n entries is O(n). Ties rank the
+// lower id first.
+template <typename Score>
+class RankedSet {
+public:
+    using Id = std::uint32_t;
+    using Entry = std::pair<Score, Id>;
+
+private:
+    struct Order {
+        bool operator()(const Entry& a, const Entry& b) const {
+            return a.first != b.first ? b.first < a.first : a.second < b.second;
+        }
+    };
+    
+    std::set<Entry, Order> entries;
+    std::vector<Score> scores;          // indexed by id
+    std::vector<bool> present;
+
+public:
+    // Modification
+    void assign(Id id, Score score);
+    bool erase(Id id);
+    void clear();
+    
+    // Queries
+    bool contains(Id id) const { return id < present.size() && present[id]; }
+    const Score& scoreOf(Id id) const { return scores[id]; }
+    std::vector<Entry> top(std::size_t limit) const;
+    std::size_t size() const { return entries.size(); }
+    bool empty() const { return entries.empty(); }
+};
+
+template <typename Score>
+void RankedSet<Score>::assign(Id id, Score score) {
+    if (id >= scores.size()) {
+        scores.resize(id + 1);
+        present.resize(id + 1, false);
+    }
+    
+    if (present[id]) {
+        auto node = entries.extract(Entry(scores[id], id));
+        node.value().first = score;
+        entries.insert(std::move(node));
+    } else {
+        entries.insert(Entry(score, id));
+        present[id] = true;
+    }
+    scores[id] = score;
+}
+
+template <typename Score>
+bool RankedSet<Score>::erase(Id id) {
+    if (!contains(id)) {
+        return false;
+    }
+    entries.erase(Entry(scores[id], id));
+    present[id] = false;
+    return true;
+}
+
+template <typename Score>
+void RankedSet<Score>::clear() {
+    entries.clear();
+    scores.clear();
+    present.clear();
+}
+
+template <typename Score>
+std::vector<typename RankedSet<Score>::Entry> RankedSet<Score>::top(std::size_t limit) const {
+    std::vector<Entry> result;
+    for (auto it = entries.begin(); it != entries.end() && result.size() < limit; ++it) {
+        result.push_back(*it);
+    }
+    return result;
+}
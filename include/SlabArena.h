@@ -0,0 +1,93 @@
+#pragma once
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+// Bump allocator carving blocks out of fixed-size slabs, with per-size-class
+// free lists so blocks returned by growing containers are reused. Requests
+// larger than a slab get a block of their own, sized to their class (a whole
+// number of slabs); the arena keeps it and recycles it through the same free
+// lists. Memory is only given back to the heap in bulk by release() or the
+// destructor; reset() keeps it for the next round, so once an arena has grown
+// to its high-water mark it stops touching the heap.
+class SlabArena {
+public:
+    struct Stats {
+        std::size_t slabCount = 0;        // slabs currently held
+        std::size_t bytesReserved = 0;    // bytes held in slabs and large blocks
+        std::size_t bytesInUse = 0;       // bytes in live blocks, rounded to their size class
+        std::size_t allocations = 0;      // blocks handed out
+        std::size_t recycled = 0;         // of those, served from a free list
+        std::size_t heapAllocations = 0;  // calls into the general heap (slabs and large blocks)
+        std::size_t largeBlocks = 0;      // live blocks bigger than a slab
+    };
+    
+    static constexpr std::size_t defaultSlabSize = 64 * 1024;
+
+private:
+    static constexpr std::size_t minBlockSize = 16;
+    static constexpr std::size_t classCount = 28;
+    
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+    
+    struct LargeBlock {
+        unsigned char* memory;
+        std::size_t sizeClass;
+    };
+    
+    std::size_t slabSize;
+    std::vector<unsigned char*> slabs;
+    std::vector<LargeBlock> largeBlocks;
+    std::size_t currentSlab;
+    std::size_t offset;
+    FreeBlock* freeLists[classCount];
+    Stats stats;
+
+public:
+    explicit SlabArena(std::size_t slabBytes = defaultSlabSize);
+    ~SlabArena();
+    SlabArena(const SlabArena&) = delete;
+    SlabArena& operator=(const SlabArena&) = delete;
+    
+    // Allocation
+    void* allocate(std::size_t bytes);
+    void deallocate(void* block, std::size_t bytes);
+    
+    // Bulk release; callers must have returned or abandoned every block
+    void reset();
+    void release();
+    
+    const Stats& getStats() const { return stats; }
+
+private:
+    static std::size_t sizeClass(std::size_t bytes);
+    void* bump(std::size_t bytes);
+    void* allocateLarge(std::size_t index);
+};
+
+// Standard allocator adaptor so containers can draw from a SlabArena.
+template <typename T>
+class ArenaAllocator {
+private:
+    SlabArena* arena;
+    
+    template <typename U> friend class ArenaAllocator;
+
+public:
+    using value_type = T;
+    
+    explicit ArenaAllocator(SlabArena& source) : arena(&source) {}
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) : arena(other.arena) {}
+    
+    T* allocate(std::size_t n) { return static_cast<T*>(arena->allocate(n * sizeof(T))); }
+    void deallocate(T* block, std::size_t n) { arena->deallocate(block, n * sizeof(T)); }
+    
+    template <typename U>
+    bool operator==(const ArenaAllocator<U>& other) const { return arena == other.arena; }
+    template <typename U>
+    bool operator!=(const ArenaAllocator<U>& other) const { return arena != other.arena; }
+};
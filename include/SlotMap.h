@@ -0,0 +1,169 @@
+#pragma once
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include "Span.h"
+
+// Generational reference into a SlotMap. The tag keeps handles for different
+// maps from being mixed up; a default-constructed handle refers to nothing.
+template <typename Tag>
+struct SlotHandle {
+    static constexpr std::uint32_t npos = static_cast<std::uint32_t>(-1);
+    
+    std::uint32_t index = npos;
+    std::uint32_t generation = 0;
+    
+    bool isNull() const { return index == npos; }
+    bool operator==(const SlotHandle& other) const { return index == other.index && generation == other.generation; }
+    bool operator!=(const SlotHandle& other) const { return !(*this == other); }
+};
+
+// Values stored densely and addressed through generational handles.
+// Insert and erase are O(1): erase moves the last value into the hole and
+// bumps the slot's generation, so handles to the erased value stop resolving
+// instead of silently pointing at whatever reuses the slot. Iteration walks
+// the dense array. Pointers returned by get() are invalidated by insert/erase.
+template <typename T, typename Tag = T>
+class SlotMap {
+public:
+    using Handle = SlotHandle<Tag>;
+    using iterator = typename std::vector<T>::iterator;
+    using const_iterator = typename std::vector<T>::const_iterator;
+
+private:
+    static constexpr std::uint32_t npos = Handle::npos;
+    
+    struct Slot {
+        std::uint32_t generation = 0;
+        std::uint32_t denseIndex = npos;   // npos while the slot is free
+        std::uint32_t nextFree = npos;
+    };
+    
+    std::vector<Slot> slots;
+    std::vector<T> values;
+    std::vector<std::uint32_t> valueSlots;  // dense index -> slot index
+    std::uint32_t freeHead;
+
+public:
+    SlotMap() : freeHead(npos) {}
+    
+    // Modification
+    Handle insert(T value);
+    bool erase(Handle handle);
+    void clear();
+    void reserve(std::size_t count);
+    void shrinkToFit();
+    
+    // Lookup
+    T* get(Handle handle);
+    const T* get(Handle handle) const;
+    bool contains(Handle handle) const { return get(handle) != nullptr; }
+    
+    // Dense iteration
+    std::size_t size() const { return values.size(); }
+    bool empty() const { return values.empty(); }
+    iterator begin() { return values.begin(); }
+    iterator end() { return values.end(); }
+    const_iterator begin() const { return values.begin(); }
+    const_iterator end() const { return values.end(); }
+    const T& valueAt(std::size_t denseIndex) const { return values[denseIndex]; }
+    Span<const T> view() const { return Span<const T>(values.data(), values.size()); }
+    Handle handleAt(std::size_t denseIndex) const;
+};
+
+template <typename T, typename Tag>
+typename SlotMap<T, Tag>::Handle SlotMap<T, Tag>::insert(T value) {
+    std::uint32_t slotIndex;
+    if (freeHead != npos) {
+        slotIndex = freeHead;
+        freeHead = slots[slotIndex].nextFree;
+    } else {
+        slotIndex = static_cast<std::uint32_t>(slots.size());
+        slots.emplace_back();
+    }
+    
+    Slot& slot = slots[slotIndex];
+    slot.denseIndex = static_cast<std::uint32_t>(values.size());
+    slot.nextFree = npos;
+    values.push_back(std::move(value));
+    valueSlots.push_back(slotIndex);
+    return Handle{slotIndex, slot.generation};
+}
+
+template <typename T, typename Tag>
+bool SlotMap<T, Tag>::erase(Handle handle) {
+    if (!contains(handle)) {
+        return false;
+    }
+    
+    // Swap the last value into the hole and repoint its slot
+    Slot& slot = slots[handle.index];
+    std::uint32_t hole = slot.denseIndex;
+    std::uint32_t last = static_cast<std::uint32_t>(values.size() - 1);
+    if (hole != last) {
+        values[hole] = std::move(values[last]);
+        valueSlots[hole] = valueSlots[last];
+        slots[valueSlots[hole]].denseIndex = hole;
+    }
+    values.pop_back();
+    valueSlots.pop_back();
+    
+    ++slot.generation;
+    slot.denseIndex = npos;
+    slot.nextFree = freeHead;
+    freeHead = handle.index;
+    return true;
+}
+
+template <typename T, typename Tag>
+void SlotMap<T, Tag>::clear() {
+    // Retire every live slot so outstanding handles go stale
+    for (std::uint32_t slotIndex : valueSlots) {
+        Slot& slot = slots[slotIndex];
+        ++slot.generation;
+        slot.denseIndex = npos;
+        slot.nextFree = freeHead;
+        freeHead = slotIndex;
+    }
+    values.clear();
+    valueSlots.clear();
+}
+
+template <typename T, typename Tag>
+void SlotMap<T, Tag>::reserve(std::size_t count) {
+    slots.reserve(count);
+    values.reserve(count);
+    valueSlots.reserve(count);
+}
+
+template <typename T, typename Tag>
+void SlotMap<T, Tag>::shrinkToFit() {
+    // Slots stay: their generations are what keep old handles from resolving
+    values.shrink_to_fit();
+    valueSlots.shrink_to_fit();
+}
+
+template <typename T, typename Tag>
+T* SlotMap<T, Tag>::get(Handle handle) {
+    if (handle.index >= slots.size()) {
+        return nullptr;
+    }
+    const Slot& slot = slots[handle.index];
+    return slot.generation == handle.generation && slot.denseIndex != npos ? &values[slot.denseIndex] : nullptr;
+}
+
+template <typename T, typename Tag>
+const T* SlotMap<T, Tag>::get(Handle handle) const {
+    if (handle.index >= slots.size()) {
+        return nullptr;
+    }
+    const Slot& slot = slots[handle.index];
+    return slot.generation == handle.generation && slot.denseIndex != npos ? &values[slot.denseIndex] : nullptr;
+}
+
+template <typename T, typename Tag>
+typename SlotMap<T, Tag>::Handle SlotMap<T, Tag>::handleAt(std::size_t denseIndex) const {
+    std::uint32_t slotIndex = valueSlots[denseIndex];
+    return Handle{slotIndex, slots[slotIndex].generation};
+}
@@ -0,0 +1,29 @@
+#pragma once
+#include <cstddef>
+
+// Non-owning view of a contiguous run of elements. Copying a Span copies two
+// words; it stays valid only while the underlying storage does not reallocate.
+template <typename T>
+class Span {
+private:
+    T* first;
+    std::size_t count;
+
+public:
+    Span() : first(nullptr), count(0) {}
+    Span(T* data, std::size_t size) : first(data), count(size) {}
+    
+    T* begin() const { return first; }
+    T* end() const { return first + count; }
+    T& operator[](std::size_t index) const { return first[index]; }
+    T* data() const { return first; }
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    
+    // Up to limit elements starting at offset, clamped to this span
+    Span page(std::size_t offset, std::size_t limit) const {
+        if (offset >= count) return Span(first + count, 0);
+        std::size_t remaining = count - offset;
+        return Span(first + offset, limit < remaining ? limit : remaining);
+    }
+};
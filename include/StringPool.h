@@ -0,0 +1,30 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include "HashIndex.h"
+
+// Dense integer handle for an interned string. Id 0 is always the empty string.
+using StringId = std::uint32_t;
+constexpr StringId EMPTY_STRING_ID = 0;
+
+// Stores each distinct string once and hands out stable ids for it.
+// Columns that repeat a small set of texts keep the 4-byte id instead of a copy.
+class StringPool {
+private:
+    std::vector<std::string> strings;
+    HashIndex<StringId> idsByText;
+
+public:
+    StringPool() : strings(1) {}
+    
+    // Interning
+    StringId intern(const std::string& text);
+    
+    // Lookup
+    const std::string& textOf(StringId id) const;
+    
+    std::size_t size() const { return strings.size(); }
+    void clear();
+};
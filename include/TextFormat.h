@@ -0,0 +1,44 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include "Money.h"
+
+// Broken-down local time; fields are plain numbers (month 1-12, day 1-31).
+// fromLocal() accepts out-of-range fields and carries them, so adding one to
+// day or second steps to the next day or second.
+struct LocalTime {
+    int year = 1970;
+    int month = 1;
+    int day = 1;
+    int hour = 0;
+    int minute = 0;
+    int second = 0;
+};
+
+// Text conversion for money and timestamps, shared by the GUI, export and import.
+// Everything writes into caller-supplied buffers and reads from character
+// ranges: no streams, no locale, no heap allocation. Local time comes from a
+// small lock-free table of UTC offsets per quarter hour, so std::localtime is
+// only called (under a lock) the first time a quarter hour is seen.
+class TextFormat {
+public:
+    // Buffer sizes that fit any value, terminator included
+    static constexpr std::size_t MONEY_BUFFER = 32;         // "-$92233720368547758.08"
+    static constexpr std::size_t TIMESTAMP_BUFFER = 20;     // "YYYY-MM-DD HH:MM:SS"
+    static constexpr std::size_t DATE_BUFFER = 11;          // "YYYY-MM-DD"
+    
+    // Formatting; each writes a terminated string and returns its length
+    static std::size_t formatMoney(char* buffer, Money amount);
+    static std::size_t formatTimestamp(char* buffer, std::chrono::system_clock::time_point time);
+    static std::size_t formatDate(char* buffer, std::chrono::system_clock::time_point time);
+    
+    // Parsing; the whole range must match or the result is left untouched
+    static bool parseMoney(const char* first, const char* last, Money& result);
+    static bool parseLocalTime(const char* first, const char* last, LocalTime& result);
+    
+    // Local time conversion
+    static LocalTime toLocal(std::chrono::system_clock::time_point time);
+    static std::chrono::system_clock::time_point fromLocal(const LocalTime& local);
+    static std::int64_t utcOffsetAt(std::chrono::system_clock::time_point time);
+};
@@ -0,0 +1,92 @@
+#pragma once
+#include <vector>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include "Money.h"
+
+// Bank totals bucketed by minute, hour and day.
+// Every recorded transaction and every change to total assets updates the
+// current bucket at all three resolutions, so coarse history is always a
+// rollup of the same events and no replay is needed. Each resolution is a ring
+// indexed by bucket number that holds a fixed window ending at the newest
+// bucket: minutes cover a day, hours 92 days and days five years. Older
+// buckets fall off the finer rings while the coarser ones keep them. Buckets
+// are aligned to UTC, and only buckets that saw activity are reported.
+//
+// Buckets keep the change in assets rather than the total, so rollups fed by
+// disjoint sources (Bank keeps one per balance stripe) can be read together
+// through the static queries; closing assets are worked back from the
+// combined current total.
+class TimeSeriesRollup {
+public:
+    enum class Resolution : std::uint8_t {
+        MINUTE,
+        HOUR,
+        DAY
+    };
+    
+    struct Point {
+        std::chrono::system_clock::time_point start;
+        std::chrono::seconds width;
+        Money closingAssets;        // total assets at the end of the bucket
+        Money volume;
+        std::uint32_t count = 0;
+    };
+    
+    using Parts = std::vector<const TimeSeriesRollup*>;
+
+private:
+    struct Slot {
+        std::int64_t bucket = -1;
+        Money assetChange;
+        Money volume;
+        std::uint32_t count = 0;
+    };
+    
+    struct Ring {
+        std::int64_t widthSeconds = 60;
+        std::int64_t capacity = 0;
+        std::vector<Slot> slots;        // slot = bucket % capacity, allocated on first use
+        std::int64_t first = -1;        // oldest bucket ever recorded
+        std::int64_t newest = -1;
+        
+        Slot& slotFor(std::int64_t seconds);
+        const Slot* find(std::int64_t bucket) const;
+        void clear();
+    };
+    
+    Ring rings[3];
+    Money assets;       // sum of every asset change recorded
+
+public:
+    TimeSeriesRollup();
+    
+    // Updates
+    void record(std::chrono::system_clock::time_point time, Money amount);
+    void recordAssets(std::chrono::system_clock::time_point time, Money change);
+    void clear();
+    Money getAssets() const { return assets; }
+    
+    // Buckets at one resolution overlapping [from, to), oldest first
+    std::vector<Point> series(Resolution resolution, std::chrono::system_clock::time_point from,
+                              std::chrono::system_clock::time_point to) const {
+        return series(Parts(1, this), resolution, from, to);
+    }
+    
+    // The finest resolution that still covers from, merged down to at most maxPoints
+    std::vector<Point> chart(std::chrono::system_clock::time_point from, std::chrono::system_clock::time_point to,
+                             std::size_t maxPoints) const {
+        return chart(Parts(1, this), from, to, maxPoints);
+    }
+    
+    // The same queries over several rollups read as one
+    static std::vector<Point> series(const Parts& parts, Resolution resolution,
+                                     std::chrono::system_clock::time_point from,
+                                     std::chrono::system_clock::time_point to);
+    static std::vector<Point> chart(const Parts& parts, std::chrono::system_clock::time_point from,
+                                    std::chrono::system_clock::time_point to, std::size_t maxPoints);
+
+private:
+    const Ring& ringFor(Resolution resolution) const { return rings[static_cast<std::size_t>(resolution)]; }
+};
@@ -1,9 +1,12 @@
 #pragma once
 #include <string>
 #include <chrono>
-#include <memory>
+#include <cstddef>
+#include <cstdint>
+#include "AccountRegistry.h"
+#include "Money.h"
 
-enum class TransactionType {
+enum class TransactionType : std::uint8_t {
     DEPOSIT,
     WITHDRAWAL,
     TRANSFER,
@@ -11,38 +14,44 @@ enum class TransactionType {
     FEE
 };
 
+constexpr std::size_t TRANSACTION_TYPE_COUNT = 5;
+
+class TransactionLedger;
+
+// Lightweight view of one row in a TransactionLedger.
+// Copying a Transaction copies a pointer and a row number; every getter reads
+// straight from the ledger's columns. A view stays valid as long as its ledger.
+// When read from an account's history, the view carries that account as its
+// perspective so the balance and description match that side of a transfer.
+// Standard descriptions are rendered from the row's type and accounts only
+// when getDescription() is called; nothing is formatted when a row is recorded.
 class Transaction {
 private:
-    std::string transactionId;
-    TransactionType type;
-    double amount;
-    std::string description;
-    std::chrono::system_clock::time_point timestamp;
-    std::string fromAccount;
-    std::string toAccount;
-    double balanceAfter;
+    const TransactionLedger* ledger;
+    std::size_t row;
+    AccountId perspective;
 
 public:
-    Transaction(TransactionType transType, double transAmount, 
-               const std::string& desc, const std::string& fromAcc = "",
-               const std::string& toAcc = "", double balanceAfterTrans = 0.0);
-    
+    Transaction(const TransactionLedger& source, std::size_t rowIndex, AccountId viewedFrom = INVALID_ACCOUNT_ID);
+
     // Getters
-    std::string getTransactionId() const { return transactionId; }
-    TransactionType getType() const { return type; }
-    double getAmount() const { return amount; }
-    std::string getDescription() const { return description; }
-    std::chrono::system_clock::time_point getTimestamp() const { return timestamp; }
-    std::string getFromAccount() const { return fromAccount; }
-    std::string getToAccount() const { return toAccount; }
-    double getBalanceAfter() const { return balanceAfter; }
-    
+    std::string getTransactionId() const;
+    TransactionType getType() const;
+    Money getAmount() const;
+    std::string getDescription() const;
+    std::chrono::system_clock::time_point getTimestamp() const;
+    std::string getFromAccount() const;
+    std::string getToAccount() const;
+    AccountId getFromAccountId() const;
+    AccountId getToAccountId() const;
+    Money getBalanceAfter() const;
+    std::size_t getRow() const { return row; }
+
     // Utility methods
     std::string getTypeString() const;
     std::string getFormattedAmount() const;
     std::string getFormattedTimestamp() const;
     std::string getFormattedBalanceAfter() const;
-    
-private:
-    void generateTransactionId();
-}; 
\ No newline at end of file
+
+    static std::string typeToString(TransactionType type);
+};
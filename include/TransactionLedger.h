@@ -0,0 +1,332 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include "Transaction.h"
+#include "AccountRegistry.h"
+#include "StringPool.h"
+#include "Money.h"
+#include "SlabArena.h"
+#include "Span.h"
+#include "HyperLogLog.h"
+#include <memory>
+
+class LedgerView;
+class LedgerRange;
+
+// Conjunctive filter over ledger rows; fields left unset match every row.
+// Amount bounds are inclusive. The direction applies to the counterparty:
+// INTO matches rows paying into it, OUT_OF rows paying out of it.
+struct TransactionFilter {
+    enum class Direction : std::uint8_t {
+        ANY,
+        INTO,
+        OUT_OF
+    };
+    
+    bool hasType = false;
+    TransactionType type = TransactionType::DEPOSIT;
+    bool hasAmountRange = false;
+    Money minAmount;
+    Money maxAmount;
+    AccountId counterparty = INVALID_ACCOUNT_ID;
+    Direction direction = Direction::ANY;
+    
+    bool matches(TransactionType rowType, Money amount, AccountId from, AccountId to) const;
+};
+
+// Running totals for one account, updated on every append that touches it.
+// Amounts and counts are per type; balances are the account's own side, and
+// the balance range starts from the opening balance given to openAccount().
+// Counterparties are counted by a HyperLogLog made on the first transfer.
+struct AccountActivity {
+    Money amounts[TRANSACTION_TYPE_COUNT];
+    std::uint32_t counts[TRANSACTION_TYPE_COUNT] = {};
+    std::chrono::system_clock::rep firstTimestamp = 0;
+    std::chrono::system_clock::rep lastTimestamp = 0;
+    Money minBalance;
+    Money maxBalance;
+    bool hasBalanceRange = false;
+    std::unique_ptr<HyperLogLog> counterparties;
+    
+    void record(TransactionType type, Money amount, std::chrono::system_clock::rep timestamp,
+                Money balanceAfter, AccountId counterparty);
+    void includeBalance(Money balance);
+    
+    Money totalOf(TransactionType type) const { return amounts[static_cast<std::size_t>(type)]; }
+    std::uint32_t countOf(TransactionType type) const { return counts[static_cast<std::size_t>(type)]; }
+    std::uint32_t transactionCount() const;
+    bool hasActivity() const { return transactionCount() > 0; }
+    std::uint64_t distinctCounterparties() const { return counterparties ? counterparties->estimate() : 0; }
+    std::chrono::system_clock::time_point firstActivity() const {
+        return std::chrono::system_clock::time_point(std::chrono::system_clock::duration(firstTimestamp));
+    }
+    std::chrono::system_clock::time_point lastActivity() const {
+        return std::chrono::system_clock::time_point(std::chrono::system_clock::duration(lastTimestamp));
+    }
+};
+
+// Append-only transaction store laid out as a structure of arrays.
+// Each field lives in its own contiguous column, so history scans read only
+// the columns they need (e.g. type and amount) without touching strings.
+// Rows are addressed by index and never move once appended, except when
+// foldInterest() rebuilds the ledger; that invalidates every row number.
+//
+// Every money movement is recorded exactly once. Per-account history is a
+// posting list of row numbers, appended for both the source and destination.
+// Timestamps never decrease from one row to the next, so the timestamp column
+// and every posting list are time-ordered and date ranges are binary searches.
+//
+// Filtered queries go through secondary row lists keyed on type and on a
+// power-of-two amount bucket; select() intersects the smallest of those and
+// the counterparty's posting list instead of scanning the ledger.
+//
+// Columns, posting lists and secondary row lists draw their storage from the
+// ledger's own slab arena, which recycles the blocks they give up as they grow,
+// large ones included. clear() and foldInterest() rewind the arena and refill
+// the memory it already holds. Not everything is arena-backed: each account's
+// first row creates its counterparty sketch, and new descriptions grow the
+// heap-backed StringPool. getAllocatorStats() reports what the arena has done.
+class TransactionLedger {
+public:
+    template <typename T>
+    using Column = std::vector<T, ArenaAllocator<T>>;
+    using RowList = Column<std::uint32_t>;
+
+private:
+    // Declared first so it outlives every container that allocates from it
+    SlabArena arena;
+    
+    Column<std::string> transactionIds;
+    Column<TransactionType> types;
+    Column<Money> amounts;
+    Column<std::chrono::system_clock::rep> timestamps;
+    Column<AccountId> fromAccounts;
+    Column<AccountId> toAccounts;
+    Column<Money> fromBalancesAfter;
+    Column<Money> toBalancesAfter;
+    
+    // Free text is interned; empty rows render their type's standard template
+    Column<StringId> descriptionIds;
+    StringPool descriptionTexts;
+    
+    // Row numbers touching each account, indexed by AccountId
+    Column<RowList> postings;
+    Column<AccountActivity> activity;
+    
+    // Secondary indexes for select(), each list ascending by row
+    Column<RowList> typeRows;           // indexed by TransactionType
+    Column<RowList> amountBuckets;      // indexed by amountBucketOf()
+    
+    // Used only to print account numbers
+    const AccountRegistry* accountRegistry;
+
+public:
+    class const_iterator {
+    private:
+        const TransactionLedger* ledger;
+        std::size_t row;
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = Transaction;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = Transaction;
+        
+        const_iterator(const TransactionLedger* source, std::size_t rowIndex) : ledger(source), row(rowIndex) {}
+        
+        Transaction operator*() const { return Transaction(*ledger, row); }
+        const_iterator& operator++() { ++row; return *this; }
+        const_iterator& operator--() { --row; return *this; }
+        const_iterator operator+(difference_type n) const { return const_iterator(ledger, row + n); }
+        const_iterator operator-(difference_type n) const { return const_iterator(ledger, row - n); }
+        difference_type operator-(const const_iterator& other) const {
+            return static_cast<difference_type>(row) - static_cast<difference_type>(other.row);
+        }
+        bool operator==(const const_iterator& other) const { return row == other.row; }
+        bool operator!=(const const_iterator& other) const { return row != other.row; }
+    };
+    
+    TransactionLedger();
+    
+    void setAccountRegistry(const AccountRegistry* registry) { accountRegistry = registry; }
+    
+    // Recording
+    std::size_t append(TransactionType type, Money amount, const std::string& description,
+                       AccountId fromAccount = INVALID_ACCOUNT_ID, AccountId toAccount = INVALID_ACCOUNT_ID,
+                       Money fromBalanceAfter = Money(), Money toBalanceAfter = Money());
+    void reserve(std::size_t rows);
+    void clear();
+    
+    // Seeds an account's balance range before its first row
+    void openAccount(AccountId accountId, Money openingBalance);
+    
+    // Compaction: INTEREST rows before cutoff are merged into one summary row per
+    // account and calendar month, then every column and index is rebuilt. The
+    // result says where each old row went, so callers can adjust what they
+    // derived from row numbers instead of replaying the ledger
+    struct FoldedCredit {
+        AccountId accountId;
+        std::chrono::system_clock::time_point timestamp;
+    };
+    struct FoldResult {
+        static constexpr std::uint32_t FOLDED = static_cast<std::uint32_t>(-1);
+        
+        std::size_t rowsFolded = 0;
+        std::size_t summariesWritten = 0;
+        std::vector<std::uint32_t> newRowOf;        // by old row; FOLDED for rows merged into a summary
+        std::vector<std::uint32_t> summaryRows;     // new rows holding a summary
+        std::vector<FoldedCredit> foldedCredits;    // every row merged into a summary
+    };
+    FoldResult foldInterest(std::chrono::system_clock::time_point cutoff);
+    
+    // Row access
+    std::size_t size() const { return types.size(); }
+    bool empty() const { return types.empty(); }
+    Transaction operator[](std::size_t row) const { return Transaction(*this, row); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, size()); }
+    
+    // Paging in recording order; a row number is also a keyset cursor, so the
+    // page after row r is page(r + 1, limit)
+    LedgerRange page(std::size_t offset, std::size_t limit) const;
+    
+    // Rows recorded in [start, end), found by binary search on the timestamp column
+    LedgerRange between(std::chrono::system_clock::time_point start,
+                        std::chrono::system_clock::time_point end) const;
+    
+    // Per-account history and its running totals
+    LedgerView history(AccountId accountId) const;
+    const AccountActivity& activityOf(AccountId accountId) const;
+    
+    // Column access for scans
+    const Column<TransactionType>& getTypes() const { return types; }
+    const Column<Money>& getAmounts() const { return amounts; }
+    const Column<std::chrono::system_clock::rep>& getTimestamps() const { return timestamps; }
+    const Column<Money>& getFromBalancesAfter() const { return fromBalancesAfter; }
+    const Column<Money>& getToBalancesAfter() const { return toBalancesAfter; }
+    const Column<AccountId>& getFromAccounts() const { return fromAccounts; }
+    const Column<AccountId>& getToAccounts() const { return toAccounts; }
+    
+    // Per-row fields
+    const std::string& transactionIdAt(std::size_t row) const { return transactionIds[row]; }
+    TransactionType typeAt(std::size_t row) const { return types[row]; }
+    Money amountAt(std::size_t row) const { return amounts[row]; }
+    std::chrono::system_clock::time_point timestampAt(std::size_t row) const {
+        return std::chrono::system_clock::time_point(std::chrono::system_clock::duration(timestamps[row]));
+    }
+    AccountId fromAccountIdAt(std::size_t row) const { return fromAccounts[row]; }
+    AccountId toAccountIdAt(std::size_t row) const { return toAccounts[row]; }
+    const std::string& fromAccountAt(std::size_t row) const { return accountNumberOf(fromAccounts[row]); }
+    const std::string& toAccountAt(std::size_t row) const { return accountNumberOf(toAccounts[row]); }
+    Money fromBalanceAfterAt(std::size_t row) const { return fromBalancesAfter[row]; }
+    Money toBalanceAfterAt(std::size_t row) const { return toBalancesAfter[row]; }
+    const std::string& descriptionAt(std::size_t row) const { return descriptionTexts.textOf(descriptionIds[row]); }
+    
+    // Aggregates over the type and amount columns
+    Money sumAmounts(TransactionType type) const;
+    std::size_t countOf(TransactionType type) const;
+    Money sumAmounts(TransactionType type, Span<const std::uint32_t> rows) const;
+    
+    // Rows matching every attribute of the filter, ascending
+    std::vector<std::uint32_t> select(const TransactionFilter& filter) const;
+    Money smallestAmount() const;
+    Money largestAmount() const;
+    std::vector<std::uint32_t> rowsWithAmountBetween(Money low, Money high) const;
+    
+    // Storage
+    const SlabArena::Stats& getAllocatorStats() const { return arena.getStats(); }
+
+private:
+    template <typename T>
+    static void releaseColumn(Column<T>& column) { Column<T>(column.get_allocator()).swap(column); }
+    std::size_t appendRow(const std::string& transactionId, TransactionType type, Money amount,
+                          std::chrono::system_clock::rep timestamp, const std::string& description,
+                          AccountId fromAccount, AccountId toAccount, Money fromBalanceAfter, Money toBalanceAfter);
+    void addRow(Column<RowList>& lists, std::size_t key, std::size_t row);
+    void recordActivity(AccountId accountId, TransactionType type, Money amount,
+                        std::chrono::system_clock::rep timestamp, Money balanceAfter, AccountId counterparty);
+    AccountActivity& activityFor(AccountId accountId);
+    static Span<const std::uint32_t> rowsOf(const Column<RowList>& lists, std::size_t key);
+    static std::size_t amountBucketOf(Money amount);
+    bool matches(const TransactionFilter& filter, std::size_t row) const {
+        return filter.matches(types[row], amounts[row], fromAccounts[row], toAccounts[row]);
+    }
+    const std::string& accountNumberOf(AccountId id) const;
+};
+
+// Contiguous run of ledger rows in recording order.
+class LedgerRange {
+private:
+    const TransactionLedger* ledger;
+    std::size_t first;
+    std::size_t last;
+
+public:
+    LedgerRange(const TransactionLedger& source, std::size_t firstRow, std::size_t endRow)
+        : ledger(&source), first(firstRow), last(endRow) {}
+    
+    std::size_t size() const { return last - first; }
+    bool empty() const { return first == last; }
+    Transaction operator[](std::size_t index) const { return Transaction(*ledger, first + index); }
+    TransactionLedger::const_iterator begin() const { return TransactionLedger::const_iterator(ledger, first); }
+    TransactionLedger::const_iterator end() const { return TransactionLedger::const_iterator(ledger, last); }
+};
+
+// One account's history: a slice of its posting list, oldest first.
+// Rows are read through the account's perspective, so transfers show the
+// balance and direction that apply to that account. A view holds only a
+// pointer into the posting list and is invalidated by the next append.
+class LedgerView {
+private:
+    const TransactionLedger* ledger;
+    Span<const std::uint32_t> rows;
+    AccountId perspective;
+
+public:
+    class const_iterator {
+    private:
+        const LedgerView* view;
+        std::size_t index;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Transaction;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = Transaction;
+        
+        const_iterator(const LedgerView* source, std::size_t position) : view(source), index(position) {}
+        
+        Transaction operator*() const { return (*view)[index]; }
+        const_iterator& operator++() { ++index; return *this; }
+        bool operator==(const const_iterator& other) const { return index == other.index; }
+        bool operator!=(const const_iterator& other) const { return index != other.index; }
+    };
+    
+    LedgerView() : ledger(nullptr), perspective(INVALID_ACCOUNT_ID) {}
+    LedgerView(const TransactionLedger& source, Span<const std::uint32_t> postingRows, AccountId accountId)
+        : ledger(&source), rows(postingRows), perspective(accountId) {}
+    
+    std::size_t size() const { return rows.size(); }
+    bool empty() const { return rows.empty(); }
+    Transaction operator[](std::size_t index) const { return Transaction(*ledger, rows[index], perspective); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, size()); }
+    AccountId getAccountId() const { return perspective; }
+    
+    // Paging: by position, after a known row (keyset), or the most recent entries
+    LedgerView page(std::size_t offset, std::size_t limit) const { return LedgerView(*ledger, rows.page(offset, limit), perspective); }
+    LedgerView after(std::size_t row, std::size_t limit) const;
+    LedgerView latest(std::size_t limit) const { return page(size() > limit ? size() - limit : 0, limit); }
+    
+    // Entries recorded in [start, end)
+    LedgerView between(std::chrono::system_clock::time_point start,
+                       std::chrono::system_clock::time_point end) const;
+    
+    Money sumAmounts(TransactionType type) const { return ledger ? ledger->sumAmounts(type, rows) : Money(); }
+};
@@ -0,0 +1,221 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <cctype>
+#include <cstddef>
+#include <cstdint>
+
+// Fuzzy text index over documents addressed by small dense ids.
+// Text is lower-cased and split into alphanumeric words; each word, padded
+// with two leading spaces and one trailing space, contributes its trigrams.
+// Every trigram maps to a sorted list of document ids, so a query reads only
+// the lists for its own trigrams. Query words are not padded at the end,
+// which lets a partly typed word match as a prefix.
+//
+// A document matches when it shares at least half of the query's trigrams.
+// Candidates come from the shortest lists that any such document must appear
+// in; the longer lists are only probed by binary search. Results are ranked
+// by shared trigrams, then by shorter documents.
+template <typename Value>
+class TrigramIndex {
+public:
+    using DocId = std::uint32_t;
+
+private:
+    using Trigram = std::uint32_t;
+    
+    struct Document {
+        Value value{};
+        std::vector<Trigram> trigrams;      // sorted, unique
+        bool live = false;
+    };
+    
+    std::vector<Document> documents;
+    std::unordered_map<Trigram, std::vector<DocId>> postings;
+    std::size_t liveCount;
+
+public:
+    TrigramIndex() : liveCount(0) {}
+    
+    // Modification
+    void assign(DocId id, const Value& value, const std::string& text);
+    bool erase(DocId id);
+    void clear();
+    
+    // Queries
+    std::vector<Value> search(const std::string& query, std::size_t limit) const;
+    
+    // Size
+    std::size_t size() const { return liveCount; }
+    bool empty() const { return liveCount == 0; }
+
+private:
+    static std::vector<Trigram> trigramsOf(const std::string& text, bool padEnd);
+    void unlink(DocId id);
+};
+
+template <typename Value>
+void TrigramIndex<Value>::assign(DocId id, const Value& value, const std::string& text) {
+    if (id >= documents.size()) {
+        documents.resize(id + 1);
+    }
+    unlink(id);
+    
+    Document& document = documents[id];
+    document.value = value;
+    document.trigrams = trigramsOf(text, true);
+    document.live = true;
+    ++liveCount;
+    
+    // New documents usually carry the highest id, so this is normally an append
+    for (Trigram trigram : document.trigrams) {
+        std::vector<DocId>& ids = postings[trigram];
+        if (ids.empty() || ids.back() < id) {
+            ids.push_back(id);
+        } else {
+            ids.insert(std::lower_bound(ids.begin(), ids.end(), id), id);
+        }
+    }
+}
+
+template <typename Value>
+bool TrigramIndex<Value>::erase(DocId id) {
+    if (id >= documents.size() || !documents[id].live) {
+        return false;
+    }
+    unlink(id);
+    documents[id].value = Value{};
+    return true;
+}
+
+template <typename Value>
+void TrigramIndex<Value>::clear() {
+    documents.clear();
+    postings.clear();
+    liveCount = 0;
+}
+
+template <typename Value>
+std::vector<Value> TrigramIndex<Value>::search(const std::string& query, std::size_t limit) const {
+    std::vector<Value> result;
+    std::vector<Trigram> trigrams = trigramsOf(query, false);
+    if (trigrams.empty() || limit == 0) {
+        return result;
+    }
+    
+    // A trigram nobody has still counts against the threshold
+    std::vector<const std::vector<DocId>*> lists;
+    for (Trigram trigram : trigrams) {
+        auto found = postings.find(trigram);
+        if (found != postings.end()) {
+            lists.push_back(&found->second);
+        }
+    }
+    std::size_t needed = std::max<std::size_t>(1, trigrams.size() / 2);
+    if (lists.size() < needed) {
+        return result;
+    }
+    std::sort(lists.begin(), lists.end(),
+              [](const std::vector<DocId>* a, const std::vector<DocId>* b) { return a->size() < b->size(); });
+    
+    // Any match appears in at least one of the shortest (lists - needed + 1) lists
+    std::size_t scanned = lists.size() - needed + 1;
+    std::vector<DocId> candidates;
+    for (std::size_t i = 0; i < scanned; ++i) {
+        candidates.insert(candidates.end(), lists[i]->begin(), lists[i]->end());
+    }
+    std::sort(candidates.begin(), candidates.end());
+    
+    struct Scored {
+        DocId id;
+        std::size_t shared;
+    };
+    std::vector<Scored> scored;
+    for (std::size_t first = 0; first < candidates.size();) {
+        std::size_t last = first;
+        while (last < candidates.size() && candidates[last] == candidates[first]) {
+            ++last;
+        }
+        
+        DocId id = candidates[first];
+        std::size_t shared = last - first;
+        for (std::size_t i = scanned; i < lists.size() && shared + (lists.size() - i) >= needed; ++i) {
+            if (std::binary_search(lists[i]->begin(), lists[i]->end(), id)) ++shared;
+        }
+        if (shared >= needed) {
+            scored.push_back({id, shared});
+        }
+        first = last;
+    }
+    
+    std::size_t count = std::min(limit, scored.size());
+    std::partial_sort(scored.begin(), scored.begin() + count, scored.end(),
+                      [this](const Scored& a, const Scored& b) {
+                          if (a.shared != b.shared) return a.shared > b.shared;
+                          std::size_t lengthA = documents[a.id].trigrams.size();
+                          std::size_t lengthB = documents[b.id].trigrams.size();
+                          return lengthA != lengthB ? lengthA < lengthB : a.id < b.id;
+                      });
+    
+    result.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        result.push_back(documents[scored[i].id].value);
+    }
+    return result;
+}
+
+template <typename Value>
+std::vector<typename TrigramIndex<Value>::Trigram> TrigramIndex<Value>::trigramsOf(const std::string& text, bool padEnd) {
+    std::vector<Trigram> trigrams;
+    std::string word;
+    
+    auto flush = [&trigrams, &word, padEnd]() {
+        if (word.empty()) return;
+        std::string padded = "  " + word + (padEnd ? " " : "");
+        for (std::size_t i = 0; i + 3 <= padded.size(); ++i) {
+            trigrams.push_back(static_cast<Trigram>(static_cast<unsigned char>(padded[i])) << 16 |
+                               static_cast<Trigram>(static_cast<unsigned char>(padded[i + 1])) << 8 |
+                               static_cast<Trigram>(static_cast<unsigned char>(padded[i + 2])));
+        }
+        word.clear();
+    };
+    
+    for (char c : text) {
+        if (std::isalnum(static_cast<unsigned char>(c))) {
+            word.push_back(static_cast<char>(std::tolower(static_cast<unsigned char>(c))));
+        } else {
+            flush();
+        }
+    }
+    flush();
+    
+    std::sort(trigrams.begin(), trigrams.end());
+    trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+    return trigrams;
+}
+
+template <typename Value>
+void TrigramIndex<Value>::unlink(DocId id) {
+    Document& document = documents[id];
+    if (!document.live) {
+        return;
+    }
+    
+    for (Trigram trigram : document.trigrams) {
+        auto found = postings.find(trigram);
+        if (found == postings.end()) continue;
+        std::vector<DocId>& ids = found->second;
+        auto position = std::lower_bound(ids.begin(), ids.end(), id);
+        if (position != ids.end() && *position == id) {
+            ids.erase(position);
+        }
+        if (ids.empty()) {
+            postings.erase(found);
+        }
+    }
+    document.trigrams.clear();
+    document.live = false;
+    --liveCount;
+}
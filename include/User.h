@@ -3,7 +3,11 @@
 #include <vector>
 #include <memory>
 #include <chrono>
-#include "Account.h"
+#include <functional>
+#include "AccountRegistry.h"
+
+class User;
+using UserHandle = SlotHandle<User>;
 
 enum class UserRole {
     CUSTOMER,
@@ -11,6 +15,11 @@ enum class UserRole {
 };
 
 class User {
+public:
+    // Receives the user and the new first name, last name, email and phone
+    using ProfileChangeCallback = std::function<void(const User&, const std::string&, const std::string&,
+                                                     const std::string&, const std::string&)>;
+
 private:
     std::string userId;
     std::string username;
@@ -20,10 +29,12 @@ private:
     std::string email;
     std::string phoneNumber;
     UserRole role;
-    std::vector<std::shared_ptr<Account>> accounts;
+    std::vector<AccountHandle> accountHandles;
     std::chrono::system_clock::time_point createdAt;
     bool isActive;
     std::chrono::system_clock::time_point lastLogin;
+    
+    ProfileChangeCallback onProfileChangeCallback;
 
 public:
     User(const std::string& user, const std::string& pass, const std::string& first, 
@@ -43,9 +54,10 @@ public:
     std::chrono::system_clock::time_point getLastLogin() const { return lastLogin; }
     
     // Account management
-    void addAccount(std::shared_ptr<Account> account);
-    std::vector<std::shared_ptr<Account>> getAccounts() const;
-    std::shared_ptr<Account> getAccount(const std::string& accountNumber) const;
+    void addAccount(AccountHandle account);
+    const std::vector<AccountHandle>& getAccountHandles() const { return accountHandles; }
+    bool ownsAccount(AccountHandle account) const;
+    bool replaceAccount(AccountHandle previous, AccountHandle current);
     
     // Authentication
     bool authenticate(const std::string& password) const;
@@ -58,6 +70,12 @@ public:
     void updateProfile(const std::string& first, const std::string& last, 
                       const std::string& emailAddr, const std::string& phone);
     
+    // Called with the new profile before an update is applied, while the old one
+    // is still readable (used by Bank to keep its indexes current)
+    void setOnProfileChange(ProfileChangeCallback callback) {
+        onProfileChangeCallback = callback;
+    }
+    
     // Utility
     std::string getRoleString() const;
     std::string getFormattedLastLogin() const;
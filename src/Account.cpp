@@ -1,26 +1,17 @@
 #include "Account.h"
-#include "Transaction.h"
-#include <random>
-#include <sstream>
-#include <iomanip>
+#include "IdGenerator.h"
 #include <chrono>
 #include <ctime>
 
 // Base Account implementation
-Account::Account(const std::string& holderName, AccountType accType, double initialBalance)
-    : accountHolderName(holderName), type(accType), balance(initialBalance), isActive(true) {
+Account::Account(const std::string& holderName, AccountType accType, Money initialBalance)
+    : id(INVALID_ACCOUNT_ID), accountHolderName(holderName), type(accType), balance(initialBalance), isActive(true) {
     generateAccountNumber();
     createdAt = std::chrono::system_clock::now();
 }
 
 void Account::generateAccountNumber() {
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<> dis(100000000, 999999999);
-    
-    std::ostringstream oss;
-    oss << getAccountTypePrefix() << std::setw(9) << std::setfill('0') << dis(gen);
-    accountNumber = oss.str();
+    accountNumber = IdGenerator::nextAccountNumber(getAccountTypePrefix());
 }
 
 std::string Account::getAccountTypePrefix() const {
@@ -32,63 +23,46 @@ std::string Account::getAccountTypePrefix() const {
     }
 }
 
-bool Account::deposit(double amount) {
-    if (amount <= 0 || !isActive) return false;
+bool Account::deposit(Money amount) {
+    if (!amount.isPositive() || !isActive) return false;
     
     balance += amount;
-    
-    auto transaction = std::make_shared<Transaction>(
-        TransactionType::DEPOSIT, amount, "Deposit", "", accountNumber, balance
-    );
-    addTransaction(transaction);
-    
     return true;
 }
 
-bool Account::withdraw(double amount) {
-    if (amount <= 0 || !isActive || balance < amount) return false;
-    
-    balance -= amount;
-    
-    auto transaction = std::make_shared<Transaction>(
-        TransactionType::WITHDRAWAL, amount, "Withdrawal", accountNumber, "", balance
-    );
-    addTransaction(transaction);
-    
-    return true;
+bool Account::withdraw(Money amount) {
+    switch (type) {
+        case AccountType::SAVINGS: return static_cast<SavingsAccount*>(this)->withdraw(amount);
+        case AccountType::CHECKING: return static_cast<CheckingAccount*>(this)->withdraw(amount);
+        case AccountType::BUSINESS: return static_cast<BusinessAccount*>(this)->withdraw(amount);
+        default: return false;
+    }
 }
 
-bool Account::transfer(Account& targetAccount, double amount) {
-    if (amount <= 0 || !isActive || balance < amount) return false;
+bool Account::transfer(Account& targetAccount, Money amount) {
+    if (!amount.isPositive() || !isActive || balance < amount) return false;
     
     balance -= amount;
     targetAccount.balance += amount;
-    
-    auto transaction = std::make_shared<Transaction>(
-        TransactionType::TRANSFER, amount, "Transfer to " + targetAccount.getAccountNumber(),
-        accountNumber, targetAccount.getAccountNumber(), balance
-    );
-    addTransaction(transaction);
-    
-    auto targetTransaction = std::make_shared<Transaction>(
-        TransactionType::TRANSFER, amount, "Transfer from " + accountNumber,
-        accountNumber, targetAccount.getAccountNumber(), targetAccount.getBalance()
-    );
-    targetAccount.addTransaction(targetTransaction);
-    
     return true;
 }
 
-void Account::addTransaction(std::shared_ptr<Transaction> transaction) {
-    transactions.push_back(transaction);
-}
-
-std::vector<std::shared_ptr<Transaction>> Account::getTransactions() const {
-    return transactions;
+Money Account::calculateInterest() const {
+    switch (type) {
+        case AccountType::SAVINGS: return static_cast<const SavingsAccount*>(this)->calculateInterest();
+        case AccountType::CHECKING: return static_cast<const CheckingAccount*>(this)->calculateInterest();
+        case AccountType::BUSINESS: return static_cast<const BusinessAccount*>(this)->calculateInterest();
+        default: return Money();
+    }
 }
 
-void Account::applyInterest() {
-    // Base implementation does nothing
+Money Account::applyInterest() {
+    switch (type) {
+        case AccountType::SAVINGS: return static_cast<SavingsAccount*>(this)->applyInterest();
+        case AccountType::CHECKING: return static_cast<CheckingAccount*>(this)->applyInterest();
+        case AccountType::BUSINESS: return static_cast<BusinessAccount*>(this)->applyInterest();
+        default: return Money();
+    }
 }
 
 std::string Account::getAccountTypeString() const {
@@ -101,66 +75,23 @@ std::string Account::getAccountTypeString() const {
 }
 
 std::string Account::getFormattedBalance() const {
-    std::ostringstream oss;
-    oss << std::fixed << std::setprecision(2) << "$" << balance;
-    return oss.str();
+    return balance.toString();
 }
 
 // SavingsAccount implementation
-SavingsAccount::SavingsAccount(const std::string& holderName, double initialBalance)
-    : Account(holderName, AccountType::SAVINGS, initialBalance), interestRate(0.025) {
+SavingsAccount::SavingsAccount(const std::string& holderName, Money initialBalance)
+    : AccountOf(holderName, AccountType::SAVINGS, initialBalance), interestRate(0.025) {
     lastInterestDate = std::chrono::system_clock::now();
 }
 
-double SavingsAccount::calculateInterest() const {
-    auto now = std::chrono::system_clock::now();
-    auto duration = std::chrono::duration_cast<std::chrono::hours>(now - lastInterestDate);
-    double hours = duration.count();
-    
-    // Calculate daily interest
-    double dailyRate = interestRate / 365.0;
-    double days = hours / 24.0;
-    
-    return balance * dailyRate * days;
-}
-
-void SavingsAccount::applyInterest() {
-    double interest = calculateInterest();
-    if (interest > 0) {
-        balance += interest;
-        lastInterestDate = std::chrono::system_clock::now();
-        
-        auto transaction = std::make_shared<Transaction>(
-            TransactionType::INTEREST, interest, "Interest earned", "", accountNumber, balance
-        );
-        addTransaction(transaction);
-    }
-}
-
 // CheckingAccount implementation
-CheckingAccount::CheckingAccount(const std::string& holderName, double initialBalance)
-    : Account(holderName, AccountType::CHECKING, initialBalance), overdraftLimit(500.0) {
-}
-
-bool CheckingAccount::withdraw(double amount) {
-    if (amount <= 0 || !isActive) return false;
-    
-    double availableBalance = balance + overdraftLimit;
-    if (amount > availableBalance) return false;
-    
-    balance -= amount;
-    
-    auto transaction = std::make_shared<Transaction>(
-        TransactionType::WITHDRAWAL, amount, "Withdrawal", accountNumber, "", balance
-    );
-    addTransaction(transaction);
-    
-    return true;
+CheckingAccount::CheckingAccount(const std::string& holderName, Money initialBalance)
+    : AccountOf(holderName, AccountType::CHECKING, initialBalance), overdraftLimit(Money::fromDollars(500)) {
 }
 
 // BusinessAccount implementation
 BusinessAccount::BusinessAccount(const std::string& holderName, const std::string& business, 
-                               const std::string& tax, double initialBalance)
-    : Account(holderName, AccountType::BUSINESS, initialBalance), 
-      businessName(business), taxId(tax), monthlyFee(25.0) {
+                               const std::string& tax, Money initialBalance)
+    : AccountOf(holderName, AccountType::BUSINESS, initialBalance), 
+      businessName(business), taxId(tax), monthlyFee(Money::fromDollars(25)) {
 } 
\ No newline at end of file
@@ -0,0 +1,128 @@
+#include "AccountRankings.h"
+#include "TextFormat.h"
+#include <algorithm>
+
+static bool largerAmount(const AccountRankings::RankedTransaction& a, const AccountRankings::RankedTransaction& b) {
+    return AccountRankings::ranksBefore(a, b);
+}
+
+void AccountRankings::activityRecorded(AccountId accountId, std::chrono::system_clock::time_point timestamp) {
+    // The first row after local midnight starts a new day
+    if (timestamp >= dayEnd) {
+        activityToday.clear();
+        dayEnd = nextMidnight(timestamp);
+    }
+    countActivity(accountId);
+}
+
+void AccountRankings::trackRow(const RankedTransaction& entry) {
+    // With the min-heap ordering, front() is the smallest amount kept
+    if (largestRows.size() < MAX_TRACKED_TRANSACTIONS) {
+        largestRows.push_back(entry);
+        std::push_heap(largestRows.begin(), largestRows.end(), largerAmount);
+    } else if (largerAmount(entry, largestRows.front())) {
+        std::pop_heap(largestRows.begin(), largestRows.end(), largerAmount);
+        largestRows.back() = entry;
+        std::push_heap(largestRows.begin(), largestRows.end(), largerAmount);
+    }
+}
+
+void AccountRankings::clearTransactions() {
+    // Forgets everything derived from ledger rows; balances stay
+    activityToday.clear();
+    dayEnd = std::chrono::system_clock::time_point();
+    largestRows.clear();
+}
+
+void AccountRankings::rowsRenumbered(const std::vector<std::uint32_t>& newRowOf, std::uint32_t dropped) {
+    // Renumbering keeps the survivors' order, so only the dropped entries disturb the
+    // heap. Rows that never made it are not reconsidered, so it may hold fewer entries
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < largestRows.size(); ++i) {
+        std::uint32_t row = newRowOf[largestRows[i].row];
+        if (row != dropped) {
+            largestRows[kept++] = RankedTransaction{largestRows[i].amount, row};
+        }
+    }
+    largestRows.resize(kept);
+    std::make_heap(largestRows.begin(), largestRows.end(), largerAmount);
+}
+
+void AccountRankings::creditFolded(AccountId accountId, std::chrono::system_clock::time_point timestamp) {
+    AccountId local = localId(accountId);
+    if (!countedToday(timestamp) || !activityToday.contains(local)) {
+        return;
+    }
+    std::uint32_t count = activityToday.scoreOf(local);
+    if (count > 1) {
+        activityToday.assign(local, count - 1);
+    } else {
+        activityToday.erase(local);
+    }
+}
+
+void AccountRankings::summaryAdded(std::size_t row, Money amount, AccountId accountId,
+                                   std::chrono::system_clock::time_point timestamp) {
+    // A summary is an old row under a new number, so it never starts a new day
+    if (countedToday(timestamp)) {
+        countActivity(accountId);
+    }
+    trackRow(RankedTransaction{amount, row});
+}
+
+void AccountRankings::clear() {
+    balances.clear();
+    clearTransactions();
+}
+
+std::vector<std::pair<std::uint32_t, AccountId>> AccountRankings::mostActiveToday(std::size_t limit,
+                                                                                 std::chrono::system_clock::time_point now) const {
+    // Counts from an earlier day are stale until the next row resets them
+    if (now >= dayEnd) {
+        return {};
+    }
+    return toGlobal(activityToday.top(limit));
+}
+
+std::vector<std::pair<Money, AccountId>> AccountRankings::largestBalances(std::size_t limit) const {
+    return toGlobal(balances.top(limit));
+}
+
+std::vector<AccountRankings::RankedTransaction> AccountRankings::largestTransactions(std::size_t limit) const {
+    std::vector<RankedTransaction> result(largestRows);
+    std::sort(result.begin(), result.end(), largerAmount);
+    if (result.size() > limit) {
+        result.resize(limit);
+    }
+    return result;
+}
+
+template <typename Score>
+std::vector<std::pair<Score, AccountId>> AccountRankings::toGlobal(std::vector<std::pair<Score, AccountId>> entries) const {
+    for (auto& entry : entries) {
+        entry.second = globalId(entry.second);
+    }
+    return entries;
+}
+
+void AccountRankings::countActivity(AccountId accountId) {
+    if (accountId == INVALID_ACCOUNT_ID) {
+        return;
+    }
+    AccountId local = localId(accountId);
+    std::uint32_t count = activityToday.contains(local) ? activityToday.scoreOf(local) : 0;
+    activityToday.assign(local, count + 1);
+}
+
+bool AccountRankings::countedToday(std::chrono::system_clock::time_point timestamp) const {
+    return timestamp < dayEnd && nextMidnight(timestamp) == dayEnd;
+}
+
+std::chrono::system_clock::time_point AccountRankings::nextMidnight(std::chrono::system_clock::time_point time) {
+    LocalTime local = TextFormat::toLocal(time);
+    local.hour = 0;
+    local.minute = 0;
+    local.second = 0;
+    ++local.day;
+    return TextFormat::fromLocal(local);
+}
@@ -0,0 +1,22 @@
+#include "AccountRegistry.h"
+
+AccountId AccountRegistry::intern(const std::string& accountNumber) {
+    if (const AccountId* existing = idsByNumber.find(accountNumber)) {
+        return *existing;
+    }
+    
+    AccountId id = static_cast<AccountId>(accountNumbers.size());
+    accountNumbers.push_back(accountNumber);
+    idsByNumber.insert(accountNumber, id);
+    return id;
+}
+
+AccountId AccountRegistry::find(const std::string& accountNumber) const {
+    const AccountId* id = idsByNumber.find(accountNumber);
+    return id ? *id : INVALID_ACCOUNT_ID;
+}
+
+const std::string& AccountRegistry::numberOf(AccountId id) const {
+    static const std::string none;
+    return contains(id) ? accountNumbers[id] : none;
+}
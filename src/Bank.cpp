@@ -1,11 +1,18 @@
 #include "Bank.h"
+#include "TextFormat.h"
 #include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <functional>
 #include <fstream>
-#include <sstream>
 #include <iostream>
 
 Bank::Bank(const std::string& name, const std::string& code)
-    : bankName(name), bankCode(code), totalAssets(0.0), totalAccounts(0), totalUsers(0) {
+    : bankName(name), bankCode(code) {
+    allTransactions.setAccountRegistry(&accountRegistry);
+    for (std::size_t i = 0; i < BALANCE_STRIPES; ++i) {
+        balanceStripes[i].rankings = AccountRankings(static_cast<AccountId>(i), BALANCE_STRIPES);
+    }
     initializeBank();
     usersFile = "data/users.dat";
     accountsFile = "data/accounts.dat";
@@ -22,40 +29,98 @@ void Bank::initializeBank() {
                 "john.doe@email.com", "555-1234", UserRole::CUSTOMER);
     
     // Create sample accounts for the customer
-    auto john = findUser("john");
+    const UserHandle* john = usernameIndex.find("john");
     if (john) {
-        auto savings = createAccount("John Doe", AccountType::SAVINGS, 5000.0);
-        auto checking = createAccount("John Doe", AccountType::CHECKING, 2500.0);
-        john->addAccount(savings);
-        john->addAccount(checking);
+        auto savings = createAccount("John Doe", AccountType::SAVINGS, Money::fromDollars(5000));
+        auto checking = createAccount("John Doe", AccountType::CHECKING, Money::fromDollars(2500));
+        assignAccount(*john, savings->getId());
+        assignAccount(*john, checking->getId());
     }
-    
-    updateStatistics();
 }
 
 std::string Bank::generateBankCode() {
     return "BANK" + std::to_string(std::rand() % 10000);
 }
 
+// Contact indexes list every user holding a key in the order they took it, by
+// registering with it or by a later profile change; keeping a value keeps the place
+static void addContact(HashIndex<std::vector<UserHandle>>& index, const std::string& key, UserHandle user) {
+    if (key.empty()) {
+        return;
+    }
+    if (std::vector<UserHandle>* holders = index.find(key)) {
+        holders->push_back(user);
+    } else {
+        index.insert(key, std::vector<UserHandle>(1, user));
+    }
+}
+
+static void removeContact(HashIndex<std::vector<UserHandle>>& index, const std::string& key, UserHandle user) {
+    std::vector<UserHandle>* holders = index.find(key);
+    if (!holders) {
+        return;
+    }
+    holders->erase(std::remove(holders->begin(), holders->end(), user), holders->end());
+    if (holders->empty()) {
+        index.erase(key);
+    }
+}
+
 bool Bank::registerUser(const std::string& username, const std::string& password,
                        const std::string& firstName, const std::string& lastName,
                        const std::string& email, const std::string& phone,
                        UserRole role) {
     // Check if username already exists
-    if (findUser(username)) {
+    if (usernameIndex.contains(username)) {
         return false;
     }
     
-    auto user = std::make_shared<User>(username, password, firstName, lastName, email, phone, role);
-    users.push_back(user);
-    updateUserStatistics();
+    auto user = std::make_unique<User>(username, password, firstName, lastName, email, phone, role);
+    user->setOnProfileChange([this](const User& changed, const std::string& newFirst, const std::string& newLast,
+                                    const std::string& newEmail, const std::string& newPhone) {
+        reindexUserContact(changed, newEmail, newPhone);
+        if (const UserHandle* owner = usernameIndex.find(changed.getUsername())) {
+            reindexUserSearch(*owner, changed.getUsername(), newFirst, newLast, newEmail, newPhone);
+        }
+    });
+    
+    std::string userId = user->getUserId();
+    UserHandle handle = users.insert(std::move(user));
+    userIdIndex.insert(userId, handle);
+    usernameIndex.insert(username, handle);
+    addContact(emailIndex, email, handle);
+    addContact(phoneIndex, phone, handle);
+    reindexUserSearch(handle, username, firstName, lastName, email, phone);
     return true;
 }
 
+void Bank::reindexUserContact(const User& user, const std::string& newEmail, const std::string& newPhone) {
+    auto owner = usernameIndex.find(user.getUsername());
+    if (!owner) {
+        return;
+    }
+    
+    if (newEmail != user.getEmail()) {
+        removeContact(emailIndex, user.getEmail(), *owner);
+        addContact(emailIndex, newEmail, *owner);
+    }
+    if (newPhone != user.getPhoneNumber()) {
+        removeContact(phoneIndex, user.getPhoneNumber(), *owner);
+        addContact(phoneIndex, newPhone, *owner);
+    }
+}
+
+void Bank::reindexUserSearch(UserHandle user, const std::string& username,
+                             const std::string& firstName, const std::string& lastName,
+                             const std::string& email, const std::string& phone) {
+    userSearchIndex.assign(user.index, user, username + " " + firstName + " " + lastName + " " + email + " " + phone);
+}
+
 bool Bank::authenticateUser(const std::string& username, const std::string& password) {
-    auto user = findUser(username);
+    const UserHandle* handle = usernameIndex.find(username);
+    User* user = handle ? getUser(*handle) : nullptr;
     if (user && user->authenticate(password) && user->getIsActive()) {
-        currentUser = user;
+        currentUser = *handle;
         user->recordLogin();
         return true;
     }
@@ -63,198 +128,659 @@ bool Bank::authenticateUser(const std::string& username, const std::string& pass
 }
 
 void Bank::logoutUser() {
-    currentUser = nullptr;
+    currentUser = UserHandle();
 }
 
-std::shared_ptr<Account> Bank::createAccount(const std::string& holderName, 
-                                           AccountType type, double initialBalance) {
-    std::shared_ptr<Account> account;
-    
+Account* Bank::createAccount(const std::string& holderName, 
+                             AccountType type, Money initialBalance) {
+    std::unique_lock<std::shared_mutex> structure(structureMutex);
+    Account* created = nullptr;
     switch (type) {
         case AccountType::SAVINGS:
-            account = std::make_shared<SavingsAccount>(holderName, initialBalance);
+            created = storeAccount(savingsAccounts, SavingsAccount(holderName, initialBalance));
             break;
         case AccountType::CHECKING:
-            account = std::make_shared<CheckingAccount>(holderName, initialBalance);
+            created = storeAccount(checkingAccounts, CheckingAccount(holderName, initialBalance));
             break;
         case AccountType::BUSINESS:
-            account = std::make_shared<BusinessAccount>(holderName, "Business", "TAX123", initialBalance);
+            created = storeAccount(businessAccounts, BusinessAccount(holderName, "Business", "TAX123", initialBalance));
             break;
     }
-    
-    if (account) {
-        accounts.push_back(account);
-        updateAccountStatistics();
+    return created;
+}
+
+Account* Bank::createBusinessAccount(const std::string& holderName,
+                                     const std::string& businessName,
+                                     const std::string& taxId,
+                                     Money initialBalance) {
+    std::unique_lock<std::shared_mutex> structure(structureMutex);
+    return storeAccount(businessAccounts, BusinessAccount(holderName, businessName, taxId, initialBalance));
+}
+
+template <typename T>
+Account* Bank::storeAccount(SlotMap<T, Account>& table, T account) {
+    AccountId id = accountRegistry.intern(account.getAccountNumber());
+    account.setId(id);
+    allTransactions.openAccount(id, account.getBalance());
+    holderNameIndex.insert(normalizeHolderName(account.getAccountHolderName()), id);
+    accountNumberIndex.insert(account.getAccountNumber(), id);
+    accountSearchIndex.assign(id, id, account.getAccountNumber() + " " + account.getAccountHolderName());
+    BalanceStripe& stripe = stripeOf(id);
+    stripe.statistics.accountAdded(account.getType(), account.getBalance(), account.getIsActive());
+    if (account.getIsActive()) {
+        stripe.rankings.balanceChanged(id, account.getBalance());
+        if (!account.getBalance().isZero()) {
+            stripe.rollups.recordAssets(std::chrono::system_clock::now(), account.getBalance());
+        }
     }
     
-    return account;
+    AccountHandle handle{account.getType(), table.insert(std::move(account))};
+    if (id >= accountHandles.size()) {
+        accountHandles.resize(id + 1);
+    }
+    accountHandles[id] = handle;
+    return table.get(handle.slot);
+}
+
+template <typename Visitor>
+void Bank::forEachAccountTable(Visitor&& visit) {
+    visit(savingsAccounts);
+    visit(checkingAccounts);
+    visit(businessAccounts);
+}
+
+template <typename Visitor>
+void Bank::forEachTablePair(Visitor&& visit) {
+    visit(savingsAccounts, archivedSavings);
+    visit(checkingAccounts, archivedChecking);
+    visit(businessAccounts, archivedBusiness);
 }
 
-std::shared_ptr<Account> Bank::createBusinessAccount(const std::string& holderName,
-                                                    const std::string& businessName,
-                                                    const std::string& taxId,
-                                                    double initialBalance) {
-    auto account = std::make_shared<BusinessAccount>(holderName, businessName, taxId, initialBalance);
-    accounts.push_back(account);
-    updateAccountStatistics();
-    return account;
+Account* Bank::getAccount(const std::string& accountNumber) {
+    return getAccount(accountRegistry.find(accountNumber));
 }
 
-std::shared_ptr<Account> Bank::getAccount(const std::string& accountNumber) const {
-    for (const auto& account : accounts) {
-        if (account->getAccountNumber() == accountNumber) {
-            return account;
+Account* Bank::getAccount(AccountId accountId) {
+    return getAccount(getAccountHandle(accountId));
+}
+
+Account* Bank::getAccount(AccountHandle account) {
+    if (account.archived) {
+        switch (account.type) {
+            case AccountType::SAVINGS: return archivedSavings.get(account.slot);
+            case AccountType::CHECKING: return archivedChecking.get(account.slot);
+            case AccountType::BUSINESS: return archivedBusiness.get(account.slot);
+            default: return nullptr;
         }
     }
-    return nullptr;
+    switch (account.type) {
+        case AccountType::SAVINGS: return savingsAccounts.get(account.slot);
+        case AccountType::CHECKING: return checkingAccounts.get(account.slot);
+        case AccountType::BUSINESS: return businessAccounts.get(account.slot);
+        default: return nullptr;
+    }
 }
 
-std::vector<std::shared_ptr<Account>> Bank::getAllAccounts() const {
-    return accounts;
+AccountHandle Bank::getAccountHandle(AccountId accountId) const {
+    return accountId < accountHandles.size() ? accountHandles[accountId] : AccountHandle();
 }
 
-bool Bank::processTransaction(const std::string& fromAccount, const std::string& toAccount,
-                            double amount, TransactionType type, const std::string& description) {
-    auto transaction = std::make_shared<Transaction>(type, amount, description, fromAccount, toAccount);
-    allTransactions.push_back(transaction);
+bool Bank::assignAccount(UserHandle owner, AccountId accountId) {
+    User* user = getUser(owner);
+    AccountHandle account = getAccountHandle(accountId);
+    if (!user || !getAccount(account)) {
+        return false;
+    }
+    if (accountId >= accountOwners.size()) {
+        accountOwners.resize(accountId + 1);
+    }
+    if (getUser(accountOwners[accountId])) {
+        return false;
+    }
     
-    // Add transaction to relevant accounts
-    if (!fromAccount.empty()) {
-        auto account = getAccount(fromAccount);
-        if (account) {
-            account->addTransaction(transaction);
+    user->addAccount(account);
+    accountOwners[accountId] = owner;
+    return true;
+}
+
+std::vector<Account*> Bank::getUserAccounts(const User& user) {
+    // Handles to accounts that no longer exist are skipped
+    std::vector<Account*> result;
+    result.reserve(user.getAccountHandles().size());
+    for (AccountHandle handle : user.getAccountHandles()) {
+        if (Account* account = getAccount(handle)) {
+            result.push_back(account);
         }
     }
-    
-    if (!toAccount.empty() && fromAccount != toAccount) {
-        auto account = getAccount(toAccount);
-        if (account) {
-            account->addTransaction(transaction);
+    return result;
+}
+
+std::vector<Account*> Bank::resolveAccounts(const std::vector<AccountId>& accountIds) {
+    std::vector<Account*> result;
+    result.reserve(accountIds.size());
+    for (AccountId id : accountIds) {
+        if (Account* account = getAccount(id)) {
+            result.push_back(account);
         }
     }
+    return result;
+}
+
+std::vector<Account*> Bank::getAccounts(AccountId first, std::size_t limit) {
+    // Keyset paging in creation order: the next page starts after the last id returned
+    std::vector<Account*> result;
+    for (AccountId id = first; id < accountHandles.size() && result.size() < limit; ++id) {
+        if (accountHandles[id].archived) continue;
+        if (Account* account = getAccount(accountHandles[id])) {
+            result.push_back(account);
+        }
+    }
+    return result;
+}
+
+std::size_t Bank::getAccountCount() const {
+    return savingsAccounts.size() + checkingAccounts.size() + businessAccounts.size();
+}
+
+std::size_t Bank::getArchivedAccountCount() const {
+    return archivedSavings.size() + archivedChecking.size() + archivedBusiness.size();
+}
+
+bool Bank::processTransaction(const std::string& fromAccount, const std::string& toAccount,
+                            Money amount, TransactionType type, const std::string& description) {
+    std::shared_lock<std::shared_mutex> structure(structureMutex);
+    AccountId fromId = accountRegistry.find(fromAccount);
+    AccountId toId = accountRegistry.find(toAccount);
     
+    // Both balances are read for the row, so their stripes are held like a transfer's
+    BalanceLocks balances = lockBalances(fromId, toId);
+    recordTransaction(fromId, toId, amount, type, description);
     return true;
 }
 
-std::vector<std::shared_ptr<Transaction>> Bank::getTransactionHistory(const std::string& accountNumber) const {
-    auto account = getAccount(accountNumber);
-    return account ? account->getTransactions() : std::vector<std::shared_ptr<Transaction>>();
+bool Bank::processTransaction(AccountId fromAccount, AccountId toAccount,
+                            Money amount, TransactionType type, const std::string& description) {
+    std::shared_lock<std::shared_mutex> structure(structureMutex);
+    BalanceLocks balances = lockBalances(fromAccount, toAccount);
+    recordTransaction(fromAccount, toAccount, amount, type, description);
+    return true;
 }
 
-std::vector<std::shared_ptr<Transaction>> Bank::getAllTransactions() const {
-    return allTransactions;
+Bank::BalanceStripe& Bank::rowStripeOf(AccountId fromAccount, AccountId toAccount) {
+    if (fromAccount != INVALID_ACCOUNT_ID) return stripeOf(fromAccount);
+    if (toAccount != INVALID_ACCOUNT_ID) return stripeOf(toAccount);
+    return balanceStripes[0];
 }
 
-bool Bank::deposit(const std::string& accountNumber, double amount) {
-    auto account = getAccount(accountNumber);
-    if (account && account->deposit(amount)) {
-        processTransaction("", accountNumber, amount, TransactionType::DEPOSIT, "Deposit");
-        updateStatistics();
-        return true;
+Bank::BalanceLocks Bank::lockBalances(AccountId first, AccountId second) {
+    // Stripes are always taken lowest first, so opposing transfers cannot deadlock.
+    // An invalid id has no balance and takes no stripe, but a row touching no
+    // account is still counted on stripe 0, so that one is taken instead
+    std::mutex* lower = first == INVALID_ACCOUNT_ID ? nullptr : &stripeOf(first).mutex;
+    std::mutex* upper = second == INVALID_ACCOUNT_ID ? nullptr : &stripeOf(second).mutex;
+    if (!lower && !upper) {
+        lower = &rowStripeOf(first, second).mutex;
+    } else if (lower == upper) {
+        upper = nullptr;
+    } else if (lower && upper && std::less<std::mutex*>()(upper, lower)) {
+        std::swap(lower, upper);
     }
-    return false;
+    
+    BalanceLocks locks;
+    if (lower) locks.first = std::unique_lock<std::mutex>(*lower);
+    if (upper) locks.second = std::unique_lock<std::mutex>(*upper);
+    return locks;
 }
 
-bool Bank::withdraw(const std::string& accountNumber, double amount) {
-    auto account = getAccount(accountNumber);
-    if (account && account->withdraw(amount)) {
-        processTransaction(accountNumber, "", amount, TransactionType::WITHDRAWAL, "Withdrawal");
-        updateStatistics();
-        return true;
+std::chrono::system_clock::time_point Bank::recordTransaction(AccountId fromAccount, AccountId toAccount, Money amount,
+                                                             TransactionType type, const std::string& description) {
+    // Record the movement once; the ledger indexes it under both accounts
+    auto from = getAccount(fromAccount);
+    auto to = getAccount(toAccount);
+    std::size_t row;
+    std::chrono::system_clock::time_point timestamp;
+    {
+        // The append is the only step all operations share
+        std::lock_guard<std::mutex> ledger(ledgerMutex);
+        row = allTransactions.append(type, amount, description, fromAccount, toAccount,
+                                     from ? from->getBalance() : Money(), to ? to->getBalance() : Money());
+        timestamp = allTransactions.timestampAt(row);
     }
-    return false;
+    
+    BalanceStripe& rowStripe = rowStripeOf(fromAccount, toAccount);
+    rowStripe.rankings.rowRecorded(row, amount);
+    rowStripe.rollups.record(timestamp, amount);
+    if (fromAccount != INVALID_ACCOUNT_ID) {
+        stripeOf(fromAccount).rankings.activityRecorded(fromAccount, timestamp);
+    }
+    if (toAccount != INVALID_ACCOUNT_ID && toAccount != fromAccount) {
+        stripeOf(toAccount).rankings.activityRecorded(toAccount, timestamp);
+    }
+    return timestamp;
+}
+
+LedgerView Bank::getTransactionHistory(const std::string& accountNumber) const {
+    return getTransactionHistory(accountRegistry.find(accountNumber));
 }
 
-bool Bank::transfer(const std::string& fromAccount, const std::string& toAccount, double amount) {
+LedgerView Bank::getTransactionHistory(AccountId accountId) const {
+    return allTransactions.history(accountId);
+}
+
+bool Bank::deposit(const std::string& accountNumber, Money amount) {
+    std::shared_lock<std::shared_mutex> structure(structureMutex);
+    return applyDeposit(accountRegistry.find(accountNumber), amount);
+}
+
+bool Bank::withdraw(const std::string& accountNumber, Money amount) {
+    std::shared_lock<std::shared_mutex> structure(structureMutex);
+    return applyWithdrawal(accountRegistry.find(accountNumber), amount);
+}
+
+bool Bank::transfer(const std::string& fromAccount, const std::string& toAccount, Money amount,
+                    const std::string& description) {
+    std::shared_lock<std::shared_mutex> structure(structureMutex);
+    return applyTransfer(accountRegistry.find(fromAccount), accountRegistry.find(toAccount), amount, description);
+}
+
+bool Bank::deposit(AccountId accountId, Money amount) {
+    std::shared_lock<std::shared_mutex> structure(structureMutex);
+    return applyDeposit(accountId, amount);
+}
+
+bool Bank::withdraw(AccountId accountId, Money amount) {
+    std::shared_lock<std::shared_mutex> structure(structureMutex);
+    return applyWithdrawal(accountId, amount);
+}
+
+bool Bank::transfer(AccountId fromAccount, AccountId toAccount, Money amount,
+                    const std::string& description) {
+    std::shared_lock<std::shared_mutex> structure(structureMutex);
+    return applyTransfer(fromAccount, toAccount, amount, description);
+}
+
+bool Bank::applyDeposit(AccountId accountId, Money amount) {
+    auto account = getAccount(accountId);
+    if (!account) {
+        return false;
+    }
+    
+    // The row is appended before the stripe is released, so an account's rows stay in balance order
+    std::lock_guard<std::mutex> balance(stripeOf(accountId).mutex);
+    Money before = account->getBalance();
+    if (!account->deposit(amount)) {
+        return false;
+    }
+    auto timestamp = recordTransaction(INVALID_ACCOUNT_ID, accountId, amount, TransactionType::DEPOSIT);
+    recordBalanceChange(*account, before, timestamp);
+    return true;
+}
+
+bool Bank::applyWithdrawal(AccountId accountId, Money amount) {
+    auto account = getAccount(accountId);
+    if (!account) {
+        return false;
+    }
+    
+    std::lock_guard<std::mutex> balance(stripeOf(accountId).mutex);
+    Money before = account->getBalance();
+    if (!account->withdraw(amount)) {
+        return false;
+    }
+    auto timestamp = recordTransaction(accountId, INVALID_ACCOUNT_ID, amount, TransactionType::WITHDRAWAL);
+    recordBalanceChange(*account, before, timestamp);
+    return true;
+}
+
+bool Bank::applyTransfer(AccountId fromAccount, AccountId toAccount, Money amount,
+                         const std::string& description) {
     auto from = getAccount(fromAccount);
     auto to = getAccount(toAccount);
     
-    if (from && to && from->transfer(*to, amount)) {
-        processTransaction(fromAccount, toAccount, amount, TransactionType::TRANSFER, "Transfer");
-        updateStatistics();
-        return true;
+    if (!from || !to) {
+        return false;
     }
-    return false;
+    
+    BalanceLocks balances = lockBalances(fromAccount, toAccount);
+    Money fromBefore = from->getBalance();
+    Money toBefore = to->getBalance();
+    if (!from->transfer(*to, amount)) {
+        return false;
+    }
+    auto timestamp = recordTransaction(fromAccount, toAccount, amount, TransactionType::TRANSFER, description);
+    recordBalanceChange(*from, fromBefore, timestamp);
+    recordBalanceChange(*to, toBefore, timestamp);
+    return true;
 }
 
-void Bank::updateStatistics() {
-    updateAccountStatistics();
-    updateUserStatistics();
+void Bank::recordBalanceChange(const Account& account, Money before, std::chrono::system_clock::time_point time) {
+    BalanceStripe& stripe = stripeOf(account.getId());
+    stripe.statistics.balanceChanged(account.getType(), account.getIsActive(), before, account.getBalance());
+    if (account.getIsActive()) {
+        stripe.rankings.balanceChanged(account.getId(), account.getBalance());
+        stripe.rollups.recordAssets(time, account.getBalance() - before);
+    }
 }
 
-void Bank::updateAccountStatistics() {
-    totalAssets = 0.0;
-    totalAccounts = accounts.size();
-    
-    for (const auto& account : accounts) {
-        if (account->getIsActive()) {
-            totalAssets += account->getBalance();
+void Bank::updateStatistics() {
+    // Full rebuild from the account tables; regular operations never need it
+    std::unique_lock<std::shared_mutex> structure(structureMutex);
+    for (BalanceStripe& stripe : balanceStripes) {
+        stripe.statistics.clear();
+    }
+    forEachTablePair([this](auto& live, auto& archive) {
+        for (const auto& account : live) {
+            BalanceStripe& stripe = stripeOf(account.getId());
+            stripe.statistics.accountAdded(account.getType(), account.getBalance(), account.getIsActive());
+            if (account.getIsActive()) {
+                stripe.rankings.balanceChanged(account.getId(), account.getBalance());
+            }
+        }
+        for (const auto& account : archive) {
+            stripeOf(account.getId()).statistics.accountAdded(account.getType(), account.getBalance(), account.getIsActive());
         }
+    });
+}
+
+template <typename Reader>
+auto Bank::readStripes(Reader&& read) const {
+    // Every stripe is held at once, so a transfer is seen on both sides or neither
+    std::shared_lock<std::shared_mutex> structure(structureMutex);
+    std::array<std::unique_lock<std::mutex>, BALANCE_STRIPES> locks;
+    for (std::size_t i = 0; i < BALANCE_STRIPES; ++i) {
+        locks[i] = std::unique_lock<std::mutex>(balanceStripes[i].mutex);
     }
+    return read(balanceStripes);
 }
 
-void Bank::updateUserStatistics() {
-    totalUsers = users.size();
+// Every shard's top entries, reordered and cut to limit
+template <typename Stripes, typename Query>
+static auto mergeTop(const Stripes& stripes, std::size_t limit, Query query) {
+    auto merged = query(stripes.front());
+    for (std::size_t i = 1; i < stripes.size(); ++i) {
+        auto part = query(stripes[i]);
+        merged.insert(merged.end(), part.begin(), part.end());
+    }
+    using Entry = typename decltype(merged)::value_type;
+    std::sort(merged.begin(), merged.end(), [](const Entry& a, const Entry& b) { return AccountRankings::ranksBefore(a, b); });
+    if (merged.size() > limit) {
+        merged.resize(limit);
+    }
+    return merged;
 }
 
-std::shared_ptr<User> Bank::findUser(const std::string& username) const {
-    for (const auto& user : users) {
-        if (user->getUsername() == username) {
-            return user;
+Money Bank::getTotalAssets() const {
+    return readStripes([](const auto& stripes) {
+        Money total;
+        for (const BalanceStripe& stripe : stripes) {
+            total += stripe.statistics.getTotalAssets();
         }
-    }
-    return nullptr;
+        return total;
+    });
 }
 
-std::vector<std::shared_ptr<Account>> Bank::findAccountsByHolder(const std::string& holderName) const {
-    std::vector<std::shared_ptr<Account>> result;
-    for (const auto& account : accounts) {
-        if (account->getAccountHolderName() == holderName) {
-            result.push_back(account);
+int Bank::getTotalAccounts() const {
+    return readStripes([](const auto& stripes) {
+        std::size_t count = 0;
+        for (const BalanceStripe& stripe : stripes) {
+            count += stripe.statistics.getAccountCount();
         }
+        return static_cast<int>(count);
+    });
+}
+
+BankStatistics Bank::getStatistics() const {
+    return readStripes([](const auto& stripes) {
+        BankStatistics merged;
+        for (const BalanceStripe& stripe : stripes) {
+            merged.merge(stripe.statistics);
+        }
+        return merged;
+    });
+}
+
+std::vector<std::pair<Money, AccountId>> Bank::getLargestBalances(std::size_t limit) const {
+    return readStripes([limit](const auto& stripes) {
+        return mergeTop(stripes, limit, [limit](const BalanceStripe& stripe) { return stripe.rankings.largestBalances(limit); });
+    });
+}
+
+std::vector<std::pair<std::uint32_t, AccountId>> Bank::getMostActiveToday(std::size_t limit,
+                                                                          std::chrono::system_clock::time_point now) const {
+    return readStripes([limit, now](const auto& stripes) {
+        return mergeTop(stripes, limit, [limit, now](const BalanceStripe& stripe) { return stripe.rankings.mostActiveToday(limit, now); });
+    });
+}
+
+std::vector<AccountRankings::RankedTransaction> Bank::getLargestTransactions(std::size_t limit) const {
+    return readStripes([limit](const auto& stripes) {
+        return mergeTop(stripes, limit, [limit](const BalanceStripe& stripe) { return stripe.rankings.largestTransactions(limit); });
+    });
+}
+
+std::vector<TimeSeriesRollup::Point> Bank::getAssetChart(std::chrono::system_clock::time_point from,
+                                                         std::chrono::system_clock::time_point to,
+                                                         std::size_t maxPoints) const {
+    return readStripes([from, to, maxPoints](const auto& stripes) {
+        TimeSeriesRollup::Parts parts;
+        for (const BalanceStripe& stripe : stripes) {
+            parts.push_back(&stripe.rollups);
+        }
+        return TimeSeriesRollup::chart(parts, from, to, maxPoints);
+    });
+}
+
+User* Bank::getUser(UserHandle user) const {
+    auto stored = users.get(user);
+    return stored ? stored->get() : nullptr;
+}
+
+User* Bank::findUser(const std::string& username) const {
+    return findIndexedUser(usernameIndex, username);
+}
+
+User* Bank::findUserByEmail(const std::string& email) const {
+    return findContactUser(emailIndex, email);
+}
+
+User* Bank::findUserByPhone(const std::string& phone) const {
+    return findContactUser(phoneIndex, phone);
+}
+
+User* Bank::findIndexedUser(const HashIndex<UserHandle>& index, const std::string& key) const {
+    const UserHandle* handle = index.find(key);
+    return handle ? getUser(*handle) : nullptr;
+}
+
+User* Bank::findContactUser(const HashIndex<std::vector<UserHandle>>& index, const std::string& key) const {
+    // Several users may share a contact; the one who has held it longest is returned
+    const std::vector<UserHandle>* holders = index.find(key);
+    return holders && !holders->empty() ? getUser(holders->front()) : nullptr;
+}
+
+std::vector<Account*> Bank::findAccountsByHolder(const std::string& holderName) {
+    return resolveAccounts(holderNameIndex.exact(normalizeHolderName(holderName)));
+}
+
+std::vector<Account*> Bank::findAccountsByHolderPrefix(const std::string& prefix,
+                                                       std::size_t limit) {
+    return resolveAccounts(holderNameIndex.withPrefix(normalizeHolderName(prefix), limit));
+}
+
+std::vector<Transaction> Bank::findTransactionsByDate(const std::string& accountNumber,
+                                                     const std::string& startDate,
+                                                     const std::string& endDate) const {
+    std::chrono::system_clock::time_point start, end;
+    if (!parseDate(startDate, false, start) || !parseDate(endDate, true, end)) {
+        return {};
+    }
+    
+    // Two binary searches over the account's posting list, then a copy of the matches
+    LedgerView matches = getTransactionHistory(accountNumber).between(start, end);
+    return std::vector<Transaction>(matches.begin(), matches.end());
+}
+
+LedgerRange Bank::findTransactionsByDate(const std::string& startDate, const std::string& endDate) const {
+    std::chrono::system_clock::time_point start, end;
+    if (!parseDate(startDate, false, start) || !parseDate(endDate, true, end)) {
+        return LedgerRange(allTransactions, 0, 0);
+    }
+    return allTransactions.between(start, end);
+}
+
+std::vector<Transaction> Bank::findTransactions(const TransactionFilter& filter) const {
+    // Rows are shown from the counterparty's side when the filter names one
+    std::vector<Transaction> result;
+    std::vector<std::uint32_t> rows = allTransactions.select(filter);
+    result.reserve(rows.size());
+    for (std::uint32_t row : rows) {
+        result.emplace_back(allTransactions, row, filter.counterparty);
     }
     return result;
 }
 
-std::vector<std::shared_ptr<User>> Bank::getAllUsers() const {
-    return users;
+std::vector<UserHandle> Bank::searchUsers(const std::string& query, std::size_t limit) const {
+    return userSearchIndex.search(query, limit);
 }
 
-bool Bank::deleteUser(const std::string& userId) {
-    auto it = std::find_if(users.begin(), users.end(),
-                           [&userId](const std::shared_ptr<User>& user) {
-                               return user->getUserId() == userId;
-                           });
+std::vector<AccountId> Bank::searchAccounts(const std::string& query, std::size_t limit) const {
+    return accountSearchIndex.search(query, limit);
+}
+
+bool Bank::parseDate(const std::string& text, bool endOfRange, std::chrono::system_clock::time_point& result) {
+    // Accepts local "YYYY-MM-DD" or "YYYY-MM-DD HH:MM:SS"; an end date covers the whole day or second
+    LocalTime local;
+    if (!TextFormat::parseLocalTime(text.data(), text.data() + text.size(), local)) {
+        return false;
+    }
     
-    if (it != users.end()) {
-        users.erase(it);
-        updateUserStatistics();
-        return true;
+    if (endOfRange) {
+        if (text.size() > 10) {
+            ++local.second;
+        } else {
+            ++local.day;
+        }
     }
-    return false;
+    result = TextFormat::fromLocal(local);
+    return true;
 }
 
-bool Bank::deleteAccount(const std::string& accountNumber) {
-    auto it = std::find_if(accounts.begin(), accounts.end(),
-                           [&accountNumber](const std::shared_ptr<Account>& account) {
-                               return account->getAccountNumber() == accountNumber;
-                           });
+std::string Bank::normalizeHolderName(const std::string& name) {
+    // Holder names are matched case-insensitively
+    std::string normalized(name);
+    std::transform(normalized.begin(), normalized.end(), normalized.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return normalized;
+}
+
+bool Bank::deleteUser(const std::string& userId) {
+    const UserHandle* handle = userIdIndex.find(userId);
+    return handle && deleteUser(*handle);
+}
+
+bool Bank::deleteUser(UserHandle handle) {
+    User* user = getUser(handle);
+    if (!user) {
+        return false;
+    }
     
-    if (it != accounts.end()) {
-        (*it)->deactivate();
-        updateAccountStatistics();
+    // Erasing the slot invalidates the handle held by currentUser and accountOwners as well
+    user->setOnProfileChange(nullptr);
+    userIdIndex.erase(user->getUserId());
+    usernameIndex.erase(user->getUsername());
+    removeContact(emailIndex, user->getEmail(), handle);
+    removeContact(phoneIndex, user->getPhoneNumber(), handle);
+    userSearchIndex.erase(handle.index);
+    users.erase(handle);
+    return true;
+}
+
+bool Bank::deleteAccount(const std::string& accountNumber) {
+    // Deactivated accounts stay resolvable so their history remains reachable
+    std::unique_lock<std::shared_mutex> structure(structureMutex);
+    auto account = getAccount(accountNumber);
+    if (account) {
+        if (account->getIsActive()) {
+            account->deactivate();
+            BalanceStripe& stripe = stripeOf(account->getId());
+            stripe.statistics.activationChanged(account->getType(), account->getBalance(), false);
+            stripe.rankings.accountClosed(account->getId());
+            if (!account->getBalance().isZero()) {
+                stripe.rollups.recordAssets(std::chrono::system_clock::now(), -account->getBalance());
+            }
+        }
         return true;
     }
     return false;
 }
 
 void Bank::applyInterestToAllSavings() {
-    for (auto& account : accounts) {
-        if (account->getType() == AccountType::SAVINGS) {
-            account->applyInterest();
+    // Only the savings table is walked; applyInterest resolves statically
+    std::unique_lock<std::shared_mutex> structure(structureMutex);
+    for (auto& account : savingsAccounts) {
+        Money before = account.getBalance();
+        Money interest = account.applyInterest();
+        if (interest.isPositive()) {
+            auto timestamp = recordTransaction(INVALID_ACCOUNT_ID, account.getId(), interest, TransactionType::INTEREST);
+            recordBalanceChange(account, before, timestamp);
+        }
+    }
+}
+
+Bank::CompactionReport Bank::compact(std::chrono::system_clock::time_point interestCutoff) {
+    std::unique_lock<std::shared_mutex> structure(structureMutex);
+    CompactionReport report;
+    report.accountsArchived = archiveInactiveAccounts();
+    
+    TransactionLedger::FoldResult folded = allTransactions.foldInterest(interestCutoff);
+    report.interestRowsFolded = folded.rowsFolded;
+    report.interestSummaries = folded.summariesWritten;
+    if (folded.summariesWritten > 0) {
+        // Only the folded credits and their summaries change; every other row is renumbered
+        for (BalanceStripe& stripe : balanceStripes) {
+            stripe.rankings.rowsRenumbered(folded.newRowOf, TransactionLedger::FoldResult::FOLDED);
+        }
+        for (const TransactionLedger::FoldedCredit& credit : folded.foldedCredits) {
+            stripeOf(credit.accountId).rankings.creditFolded(credit.accountId, credit.timestamp);
+        }
+        for (std::uint32_t row : folded.summaryRows) {
+            AccountId accountId = allTransactions.toAccountIdAt(row);
+            stripeOf(accountId).rankings.summaryAdded(row, allTransactions.amountAt(row), accountId,
+                                                      allTransactions.timestampAt(row));
         }
     }
-    updateStatistics();
+    return report;
+}
+
+std::size_t Bank::archiveInactiveAccounts() {
+    std::size_t moved = 0;
+    forEachTablePair([this, &moved](auto& live, auto& archive) {
+        // Walk backwards: erase swaps the last value into the hole, which is already visited
+        for (std::size_t index = live.size(); index > 0; --index) {
+            auto slot = live.handleAt(index - 1);
+            auto& account = *live.get(slot);
+            if (account.getIsActive()) continue;
+            
+            // History stays reachable by number and id; only the live indexes forget it
+            AccountId id = account.getId();
+            holderNameIndex.erase(normalizeHolderName(account.getAccountHolderName()), id);
+            accountNumberIndex.erase(account.getAccountNumber(), id);
+            accountSearchIndex.erase(id);
+            
+            AccountHandle previous{account.getType(), slot};
+            AccountHandle archived{account.getType(), archive.insert(std::move(account)), true};
+            live.erase(slot);
+            accountHandles[id] = archived;
+            ++moved;
+            
+            // Only the owner holds the old handle
+            if (User* owner = id < accountOwners.size() ? getUser(accountOwners[id]) : nullptr) {
+                owner->replaceAccount(previous, archived);
+            }
+        }
+        live.shrinkToFit();
+    });
+    return moved;
 }
 
 bool Bank::saveData() {
@@ -0,0 +1,82 @@
+#include "BankStatistics.h"
+
+void BankStatistics::accountAdded(AccountType type, Money balance, bool active) {
+    TypeTotals& typeTotals = totals(type);
+    if (active) {
+        ++typeTotals.activeCount;
+        typeTotals.activeBalance += balance;
+        totalAssets += balance;
+        balanceDistribution.add(balance);
+    } else {
+        ++typeTotals.inactiveCount;
+    }
+    if (type == AccountType::CHECKING && balance.isNegative()) {
+        ++overdrawnChecking;
+    }
+}
+
+void BankStatistics::balanceChanged(AccountType type, bool active, Money before, Money after) {
+    if (active) {
+        Money delta = after - before;
+        totals(type).activeBalance += delta;
+        totalAssets += delta;
+        balanceDistribution.remove(before);
+        balanceDistribution.add(after);
+    }
+    if (type == AccountType::CHECKING && before.isNegative() != after.isNegative()) {
+        if (after.isNegative()) {
+            ++overdrawnChecking;
+        } else {
+            --overdrawnChecking;
+        }
+    }
+}
+
+void BankStatistics::activationChanged(AccountType type, Money balance, bool nowActive) {
+    // Moves the account between the active and inactive sides without touching overdrafts
+    TypeTotals& typeTotals = totals(type);
+    if (nowActive) {
+        --typeTotals.inactiveCount;
+        ++typeTotals.activeCount;
+        typeTotals.activeBalance += balance;
+        totalAssets += balance;
+        balanceDistribution.add(balance);
+    } else {
+        --typeTotals.activeCount;
+        ++typeTotals.inactiveCount;
+        typeTotals.activeBalance -= balance;
+        totalAssets -= balance;
+        balanceDistribution.remove(balance);
+    }
+}
+
+void BankStatistics::merge(const BankStatistics& other) {
+    for (std::size_t i = 0; i < ACCOUNT_TYPE_COUNT; ++i) {
+        byType[i].activeBalance += other.byType[i].activeBalance;
+        byType[i].activeCount += other.byType[i].activeCount;
+        byType[i].inactiveCount += other.byType[i].inactiveCount;
+    }
+    totalAssets += other.totalAssets;
+    overdrawnChecking += other.overdrawnChecking;
+    balanceDistribution.merge(other.balanceDistribution);
+}
+
+void BankStatistics::clear() {
+    *this = BankStatistics();
+}
+
+std::size_t BankStatistics::getActiveCount() const {
+    std::size_t count = 0;
+    for (const TypeTotals& typeTotals : byType) {
+        count += typeTotals.activeCount;
+    }
+    return count;
+}
+
+std::size_t BankStatistics::getInactiveCount() const {
+    std::size_t count = 0;
+    for (const TypeTotals& typeTotals : byType) {
+        count += typeTotals.inactiveCount;
+    }
+    return count;
+}
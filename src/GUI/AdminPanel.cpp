@@ -7,9 +7,12 @@
 #include <iostream>
 #include <sstream>
 #include <iomanip>
+#include <algorithm>
+#include <chrono>
 
 AdminPanel::AdminPanel(std::shared_ptr<Window> window, std::shared_ptr<Bank> bankSystem)
-    : Screen(window, "Admin Panel"), bank(bankSystem), showMessage(false), messageTimer(0) {
+    : Screen(window, "Admin Panel"), bank(bankSystem), messageVisible(false), messageTimer(0),
+      compactArmed(false) {
 }
 
 void AdminPanel::initialize() {
@@ -28,6 +31,8 @@ void AdminPanel::render() {
     // Render user and account lists
     renderUserList();
     renderAccountList();
+    renderRankings();
+    renderActivityChart();
     
     // Render messages
     renderMessage();
@@ -87,6 +92,7 @@ void AdminPanel::setupUI() {
     createAccountButton = std::make_shared<Button>(startX + buttonWidth + spacing, startY, buttonWidth, buttonHeight, "Create Account", "createAccount");
     backButton = std::make_shared<Button>(startX + 2*(buttonWidth + spacing), startY, buttonWidth, buttonHeight, "Back", "back");
     refreshButton = std::make_shared<Button>(startX + 3*(buttonWidth + spacing), startY, buttonWidth, buttonHeight, "Refresh", "refresh");
+    compactButton = std::make_shared<Button>(startX + 4*(buttonWidth + spacing), startY, buttonWidth, buttonHeight, "Compact", "compact");
     
     // Set up callbacks
     searchButton->setOnClick([this]() { handleSearch(); });
@@ -94,6 +100,7 @@ void AdminPanel::setupUI() {
     createAccountButton->setOnClick([this]() { handleCreateAccount(); });
     backButton->setOnClick([this]() { handleBack(); });
     refreshButton->setOnClick([this]() { handleRefresh(); });
+    compactButton->setOnClick([this]() { handleCompact(); });
     
     // Add UI elements
     addTextField(searchField);
@@ -102,6 +109,7 @@ void AdminPanel::setupUI() {
     addButton(createAccountButton);
     addButton(backButton);
     addButton(refreshButton);
+    addButton(compactButton);
 }
 
 void AdminPanel::renderSystemStats() {
@@ -111,18 +119,46 @@ void AdminPanel::renderSystemStats() {
     window->renderText("System Statistics:", 50, startY, window->getFont(), window->getPrimaryColor());
     startY += lineHeight;
     
-    // Get system statistics
+    // Get system statistics; Bank merges its per-stripe figures into one copy
+    BankStatistics stats = bank->getStatistics();
     int totalUsers = bank->getTotalUsers();
-    int totalAccounts = bank->getTotalAccounts();
-    double totalAssets = bank->getTotalAssets();
     
     std::string usersStr = "Total Users: " + std::to_string(totalUsers);
-    std::string accountsStr = "Total Accounts: " + std::to_string(totalAccounts);
-    std::string assetsStr = "Total Assets: $" + std::to_string(static_cast<int>(totalAssets));
+    std::string accountsStr = "Accounts: " + std::to_string(bank->getAccountCount());
+    std::string assetsStr = "Total Assets: " + stats.getTotalAssets().toString();
     
     window->renderText(usersStr, 50, startY, window->getFont(), window->getTextColor());
     window->renderText(accountsStr, 250, startY, window->getFont(), window->getTextColor());
     window->renderText(assetsStr, 450, startY, window->getFont(), window->getTextColor());
+    
+    // Balance percentiles of active accounts, read from the sketch
+    std::string percentilesStr = stats.getBalancePercentile(0.50).toString() + " / " +
+                                 stats.getBalancePercentile(0.95).toString() + " / " +
+                                 stats.getBalancePercentile(0.99).toString();
+    window->renderText("Balance p50 / p95 / p99:", sideColumnLeft(), startY - lineHeight, window->getFont(), window->getPrimaryColor());
+    window->renderRightAlignedText(percentilesStr, sideColumnRight(), startY, window->getFont(), window->getTextColor());
+    startY += lineHeight;
+    
+    // Per-type totals
+    const AccountType types[] = {AccountType::SAVINGS, AccountType::CHECKING, AccountType::BUSINESS};
+    const char* labels[] = {"Savings", "Checking", "Business"};
+    for (int i = 0; i < 3; ++i) {
+        std::string typeStr = std::string(labels[i]) + ": " + stats.getTotalBalance(types[i]).toString() +
+                              " (" + std::to_string(stats.getAccountCount(types[i])) + ")";
+        window->renderText(typeStr, 50 + i * 200, startY, window->getFont(), window->getSecondaryColor());
+    }
+    startY += lineHeight;
+    
+    std::string activeStr = "Active: " + std::to_string(stats.getActiveCount());
+    // Statistics cover every account ever opened; archived ones are all inactive
+    std::string inactiveStr = "Inactive: " + std::to_string(stats.getInactiveCount()) +
+                              " (" + std::to_string(bank->getArchivedAccountCount()) + " archived)";
+    std::string overdrawnStr = "Overdrawn Checking: " + std::to_string(stats.getOverdrawnCheckingCount());
+    
+    window->renderText(activeStr, 50, startY, window->getFont(), window->getSecondaryColor());
+    window->renderText(inactiveStr, 250, startY, window->getFont(), window->getSecondaryColor());
+    window->renderText(overdrawnStr, 450, startY, window->getFont(),
+                       stats.getOverdrawnCheckingCount() > 0 ? window->getErrorColor() : window->getSecondaryColor());
 }
 
 void AdminPanel::renderUserList() {
@@ -132,7 +168,17 @@ void AdminPanel::renderUserList() {
     window->renderText("User Management:", 50, startY, window->getFont(), window->getPrimaryColor());
     startY += lineHeight;
     
-    auto users = bank->getAllUsers();
+    // Only the rows on screen are visited: search hits, or the first page
+    std::vector<User*> users;
+    if (!searchQuery.empty()) {
+        for (UserHandle handle : userResults) {
+            if (User* user = bank->getUser(handle)) users.push_back(user);
+        }
+    } else {
+        for (const auto& user : bank->getUsers(0, 10)) {
+            users.push_back(user.get());
+        }
+    }
     if (users.empty()) {
         window->renderText("No users found.", 50, startY, window->getFont(), window->getSecondaryColor());
         return;
@@ -145,13 +191,10 @@ void AdminPanel::renderUserList() {
     window->renderText("Accounts", 450, startY, window->getFont(), window->getPrimaryColor());
     startY += lineHeight;
     
-    // Render users (limit to 10 for display)
-    int count = 0;
-    for (auto& user : users) {
-        if (count >= 10) break;
-        
+    // Render users
+    for (auto user : users) {
         std::string roleStr = user->isAdmin() ? "Admin" : "Customer";
-        std::string accountsStr = std::to_string(user->getAccounts().size());
+        std::string accountsStr = std::to_string(user->getAccountHandles().size());
         
         window->renderText(user->getUsername(), 50, startY, window->getFont(), window->getTextColor());
         window->renderText(user->getFirstName() + " " + user->getLastName(), 200, startY, window->getFont(), window->getTextColor());
@@ -159,11 +202,11 @@ void AdminPanel::renderUserList() {
         window->renderText(accountsStr, 450, startY, window->getFont(), window->getTextColor());
         
         startY += lineHeight;
-        count++;
     }
     
-    if (users.size() > 10) {
-        window->renderText("... and " + std::to_string(users.size() - 10) + " more users", 50, startY, window->getFont(), window->getSecondaryColor());
+    std::size_t totalUsers = bank->getUserCount();
+    if (searchQuery.empty() && totalUsers > users.size()) {
+        window->renderText("... and " + std::to_string(totalUsers - users.size()) + " more users", 50, startY, window->getFont(), window->getSecondaryColor());
     }
 }
 
@@ -174,7 +217,14 @@ void AdminPanel::renderAccountList() {
     window->renderText("Account Management:", 50, startY, window->getFont(), window->getPrimaryColor());
     startY += lineHeight;
     
-    auto accounts = bank->getAllAccounts();
+    std::vector<Account*> accounts;
+    if (!searchQuery.empty()) {
+        for (AccountId id : accountResults) {
+            if (Account* account = bank->getAccount(id)) accounts.push_back(account);
+        }
+    } else {
+        accounts = bank->getAccounts(0, 8);
+    }
     if (accounts.empty()) {
         window->renderText("No accounts found.", 50, startY, window->getFont(), window->getSecondaryColor());
         return;
@@ -187,36 +237,135 @@ void AdminPanel::renderAccountList() {
     window->renderText("Balance", 450, startY, window->getFont(), window->getPrimaryColor());
     startY += lineHeight;
     
-    // Render accounts (limit to 8 for display)
-    int count = 0;
-    for (auto& account : accounts) {
-        if (count >= 8) break;
-        
-        std::string balanceStr = "$" + std::to_string(static_cast<int>(account->getBalance()));
+    // Render accounts
+    for (auto account : accounts) {
+        std::string balanceStr = account->getFormattedBalance();
         
         window->renderText(account->getAccountNumber(), 50, startY, window->getFont(), window->getTextColor());
-        window->renderText(account->getHolderName(), 200, startY, window->getFont(), window->getTextColor());
+        window->renderText(account->getAccountHolderName(), 200, startY, window->getFont(), window->getTextColor());
         window->renderText(account->getAccountTypeString(), 350, startY, window->getFont(), window->getTextColor());
         window->renderText(balanceStr, 450, startY, window->getFont(), window->getTextColor());
         
         startY += lineHeight;
-        count++;
     }
     
-    if (accounts.size() > 8) {
-        window->renderText("... and " + std::to_string(accounts.size() - 8) + " more accounts", 50, startY, window->getFont(), window->getSecondaryColor());
+    std::size_t totalAccounts = bank->getAccountCount();
+    if (searchQuery.empty() && totalAccounts > accounts.size()) {
+        window->renderText("... and " + std::to_string(totalAccounts - accounts.size()) + " more accounts", 50, startY, window->getFont(), window->getSecondaryColor());
     }
 }
 
+int AdminPanel::sideColumnLeft() const {
+    return window->getWidth() * 7 / 12;
+}
+
+int AdminPanel::sideColumnRight() const {
+    return window->getWidth() - 50;
+}
+
+void AdminPanel::renderRankings() {
+    // Labels start at the column's left edge, figures end at its right edge
+    int startX = sideColumnLeft();
+    int endX = sideColumnRight();
+    int startY = 200;
+    int lineHeight = 20;
+    std::size_t rows = 5;
+    
+    window->renderText("Largest Balances:", startX, startY, window->getFont(), window->getPrimaryColor());
+    startY += lineHeight;
+    for (const auto& entry : bank->getLargestBalances(rows)) {
+        window->renderText(bank->getAccountNumber(entry.second), startX, startY, window->getFont(), window->getTextColor());
+        window->renderRightAlignedText(entry.first.toString(), endX, startY, window->getFont(), window->getTextColor());
+        startY += lineHeight;
+    }
+    startY += lineHeight / 2;
+    
+    window->renderText("Most Active Today:", startX, startY, window->getFont(), window->getPrimaryColor());
+    startY += lineHeight;
+    for (const auto& entry : bank->getMostActiveToday(rows, std::chrono::system_clock::now())) {
+        std::uint64_t counterparties = bank->getAccountActivity(entry.second).distinctCounterparties();
+        window->renderText(bank->getAccountNumber(entry.second), startX, startY, window->getFont(), window->getTextColor());
+        window->renderRightAlignedText(std::to_string(entry.first) + " txns, ~" + std::to_string(counterparties) + " parties",
+                                       endX, startY, window->getFont(), window->getTextColor());
+        startY += lineHeight;
+    }
+    startY += lineHeight / 2;
+    
+    window->renderText("Largest Transactions:", startX, startY, window->getFont(), window->getPrimaryColor());
+    startY += lineHeight;
+    for (const auto& entry : bank->getLargestTransactions(rows)) {
+        Transaction transaction = bank->getAllTransactions()[entry.row];
+        window->renderText(transaction.getTypeString(), startX, startY, window->getFont(), window->getTextColor());
+        window->renderRightAlignedText(entry.amount.toString(), endX, startY, window->getFont(), window->getTextColor());
+        startY += lineHeight;
+    }
+}
+
+void AdminPanel::renderActivityChart() {
+    int chartX = sideColumnLeft();
+    int chartY = 610;
+    int chartWidth = sideColumnRight() - chartX;
+    int chartHeight = 70;
+    
+    window->renderText("Last 30 Days:", chartX, chartY - 20, window->getFont(), window->getPrimaryColor());
+    window->drawRect(chartX, chartY, chartWidth, chartHeight, window->getSecondaryColor(), false);
+    
+    // At most one point per 7 pixels, read from the coarsest rollup that fits
+    auto now = std::chrono::system_clock::now();
+    auto points = bank->getAssetChart(now - std::chrono::hours(24 * 30), now, chartWidth / 7);
+    if (points.empty()) {
+        return;
+    }
+    
+    Money lowAssets = points[0].closingAssets;
+    Money highAssets = points[0].closingAssets;
+    Money highVolume;
+    for (const auto& point : points) {
+        lowAssets = std::min(lowAssets, point.closingAssets);
+        highAssets = std::max(highAssets, point.closingAssets);
+        highVolume = std::max(highVolume, point.volume);
+    }
+    double assetRange = std::max(1.0, (highAssets - lowAssets).toDouble());
+    double volumeRange = std::max(1.0, highVolume.toDouble());
+    int step = chartWidth / static_cast<int>(points.size());
+    
+    // Volume as bars, total assets as a line over them
+    int previousX = 0;
+    int previousY = 0;
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        int x = chartX + static_cast<int>(i) * step;
+        int barHeight = static_cast<int>(points[i].volume.toDouble() / volumeRange * (chartHeight - 4));
+        window->drawRect(x + 1, chartY + chartHeight - barHeight, std::max(1, step - 2), barHeight, window->getSecondaryColor());
+        
+        int y = chartY + chartHeight - 2 - static_cast<int>((points[i].closingAssets - lowAssets).toDouble() / assetRange * (chartHeight - 4));
+        if (i > 0) {
+            window->drawLine(previousX, previousY, x + step / 2, y, window->getPrimaryColor(), 2);
+        }
+        previousX = x + step / 2;
+        previousY = y;
+    }
+    
+    std::uint32_t transactionCount = 0;
+    for (const auto& point : points) {
+        transactionCount += point.count;
+    }
+    window->renderText(std::to_string(transactionCount) + " transactions", chartX + 150, chartY - 20, window->getFont(), window->getSecondaryColor());
+}
+
 void AdminPanel::handleSearch() {
     searchQuery = searchField->getText();
     if (searchQuery.empty()) {
+        userResults.clear();
+        accountResults.clear();
         showMessage("Please enter a search term");
         return;
     }
     
-    // In a real implementation, this would search through users and accounts
-    showMessage("Search functionality coming soon!");
+    // Ranked trigram matches replace the user and account lists until cleared
+    userResults = bank->searchUsers(searchQuery, 10);
+    accountResults = bank->searchAccounts(searchQuery, 8);
+    showMessage("Found " + std::to_string(userResults.size()) + " users and " +
+                std::to_string(accountResults.size()) + " accounts");
 }
 
 void AdminPanel::handleCreateUser() {
@@ -234,22 +383,42 @@ void AdminPanel::handleBack() {
 }
 
 void AdminPanel::handleRefresh() {
+    searchQuery.clear();
+    userResults.clear();
+    accountResults.clear();
     showMessage("Data refreshed!");
 }
 
+void AdminPanel::handleCompact() {
+    // Compaction rewrites the ledger, so it runs only on a second click while the prompt is showing
+    if (!compactArmed || !messageVisible) {
+        showMessage("Click Compact again to archive closed accounts and fold interest older than 90 days");
+        compactArmed = true;
+        return;
+    }
+    
+    auto cutoff = std::chrono::system_clock::now() - std::chrono::hours(24 * 90);
+    Bank::CompactionReport report = bank->compact(cutoff);
+    accountResults.clear();
+    showMessage("Archived " + std::to_string(report.accountsArchived) + " accounts, folded " +
+                std::to_string(report.interestRowsFolded) + " interest entries");
+}
+
 void AdminPanel::showMessage(const std::string& msg) {
     message = msg;
-    showMessage = true;
+    messageVisible = true;
+    compactArmed = false;
     messageTimer = 180; // Show for 3 seconds at 60 FPS
 }
 
 void AdminPanel::clearMessage() {
-    showMessage = false;
+    messageVisible = false;
     message.clear();
+    compactArmed = false;
 }
 
 void AdminPanel::renderMessage() {
-    if (showMessage && !message.empty()) {
+    if (messageVisible && !message.empty()) {
         window->renderCenteredText(message, 550, window->getFont(), window->getAccentColor());
     }
 } 
\ No newline at end of file
@@ -28,7 +28,8 @@ void DashboardScreen::initialize() {
 void DashboardScreen::render() {
     Screen::render();
     
-    // Render dashboard content
+    // Render dashboard content; the balance is re-read every frame
+    updateBalanceDisplay();
     renderUserInfo();
     renderAccountInfo();
     renderBalanceInfo();
@@ -132,12 +133,12 @@ void DashboardScreen::setupUI() {
 }
 
 void DashboardScreen::loadUserAccounts() {
+    userAccounts.clear();
+    selectedAccountIndex = 0;
     auto currentUser = bank->getCurrentUser();
     if (currentUser) {
-        userAccounts = currentUser->getAccounts();
-        if (!userAccounts.empty()) {
-            selectedAccount = userAccounts[0];
-            selectedAccountIndex = 0;
+        for (Account* account : bank->getUserAccounts(*currentUser)) {
+            userAccounts.push_back(account->getId());
         }
     }
 }
@@ -151,6 +152,7 @@ void DashboardScreen::updateWelcomeMessage() {
 }
 
 void DashboardScreen::updateBalanceDisplay() {
+    Account* selectedAccount = getSelectedAccount();
     if (selectedAccount) {
         accountInfo = "Account: " + selectedAccount->getAccountNumber() + 
                      " (" + selectedAccount->getAccountTypeString() + ")";
@@ -248,14 +250,20 @@ void DashboardScreen::handleRefresh() {
 }
 
 void DashboardScreen::selectAccount(int index) {
-    if (index >= 0 && index < userAccounts.size()) {
-        selectedAccount = userAccounts[index];
+    if (index >= 0 && index < static_cast<int>(userAccounts.size())) {
         selectedAccountIndex = index;
         updateBalanceDisplay();
         balanceOpacity = 0.0f; // Start fade-in animation
     }
 }
 
+Account* DashboardScreen::getSelectedAccount() const {
+    if (selectedAccountIndex < 0 || selectedAccountIndex >= static_cast<int>(userAccounts.size())) {
+        return nullptr;
+    }
+    return bank->getAccount(userAccounts[selectedAccountIndex]);
+}
+
 void DashboardScreen::refreshData() {
     loadUserAccounts();
     updateWelcomeMessage();
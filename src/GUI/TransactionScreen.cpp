@@ -25,7 +25,7 @@ void TransactionScreen::render() {
     // Render account selector
     auto currentUser = bank->getCurrentUser();
     if (currentUser) {
-        auto accounts = currentUser->getAccounts();
+        auto accounts = bank->getUserAccounts(*currentUser);
         if (!accounts.empty()) {
             std::string accountInfo = "Account: " + accounts[0]->getAccountNumber() + " - " + accounts[0]->getFormattedBalance();
             window->renderCenteredText(accountInfo, 80, window->getFont(), window->getSecondaryColor());
@@ -95,15 +95,16 @@ void TransactionScreen::renderTransactionList() {
     auto currentUser = bank->getCurrentUser();
     if (!currentUser) return;
     
-    auto accounts = currentUser->getAccounts();
+    auto accounts = bank->getUserAccounts(*currentUser);
     if (accounts.empty()) return;
     
-    auto transactions = bank->getTransactionHistory(accounts[0]->getAccountNumber());
-    
     int startY = 120;
     int lineHeight = 25;
     int maxTransactions = 15; // Limit to prevent overflow
     
+    // Only the newest page of the history is read
+    LedgerView transactions = bank->getTransactionHistory(accounts[0]->getId()).latest(maxTransactions);
+    
     window->renderText("Recent Transactions:", 50, startY, window->getFont(), window->getTextColor());
     startY += 30;
     
@@ -120,33 +121,32 @@ void TransactionScreen::renderTransactionList() {
     startY += lineHeight;
     
     // Render transactions (most recent first)
-    int count = 0;
-    for (auto it = transactions.rbegin(); it != transactions.rend() && count < maxTransactions; ++it, ++count) {
-        auto transaction = *it;
+    for (size_t index = transactions.size(); index > 0; --index) {
+        Transaction transaction = transactions[index - 1];
         
         // Determine color based on transaction type
         SDL_Color textColor = window->getTextColor();
-        if (transaction->getType() == TransactionType::DEPOSIT) {
+        if (transaction.getType() == TransactionType::DEPOSIT) {
             textColor = window->getSuccessColor();
-        } else if (transaction->getType() == TransactionType::WITHDRAWAL) {
+        } else if (transaction.getType() == TransactionType::WITHDRAWAL) {
             textColor = window->getErrorColor();
         }
         
         // Format date
-        std::string dateStr = transaction->getDate();
+        std::string dateStr = transaction.getFormattedTimestamp();
         if (dateStr.length() > 10) dateStr = dateStr.substr(0, 10);
         
         // Format amount
-        std::string amountStr = "$" + std::to_string(static_cast<int>(transaction->getAmount()));
-        if (transaction->getType() == TransactionType::WITHDRAWAL) {
+        std::string amountStr = transaction.getFormattedAmount();
+        if (transaction.getType() == TransactionType::WITHDRAWAL) {
             amountStr = "-" + amountStr;
         }
         
         // Render transaction row
         window->renderText(dateStr, 50, startY, window->getFont(), textColor);
-        window->renderText(transaction->getTypeString(), 200, startY, window->getFont(), textColor);
+        window->renderText(transaction.getTypeString(), 200, startY, window->getFont(), textColor);
         window->renderText(amountStr, 300, startY, window->getFont(), textColor);
-        window->renderText(transaction->getDescription(), 450, startY, window->getFont(), textColor);
+        window->renderText(transaction.getDescription(), 450, startY, window->getFont(), textColor);
         
         startY += lineHeight;
     }
@@ -156,36 +156,37 @@ void TransactionScreen::renderTransactionSummary() {
     auto currentUser = bank->getCurrentUser();
     if (!currentUser) return;
     
-    auto accounts = currentUser->getAccounts();
+    auto accounts = bank->getUserAccounts(*currentUser);
     if (accounts.empty()) return;
     
-    auto transactions = bank->getTransactionHistory(accounts[0]->getAccountNumber());
-    
-    // Calculate summary statistics
-    double totalDeposits = 0.0;
-    double totalWithdrawals = 0.0;
-    int transactionCount = transactions.size();
-    
-    for (auto& transaction : transactions) {
-        if (transaction->getType() == TransactionType::DEPOSIT) {
-            totalDeposits += transaction->getAmount();
-        } else if (transaction->getType() == TransactionType::WITHDRAWAL) {
-            totalWithdrawals += transaction->getAmount();
-        }
-    }
+    // Running totals maintained by the ledger; no history is read
+    const AccountActivity& activity = bank->getAccountActivity(accounts[0]->getId());
+    Money totalDeposits = activity.totalOf(TransactionType::DEPOSIT);
+    Money totalWithdrawals = activity.totalOf(TransactionType::WITHDRAWAL);
+    int transactionCount = activity.transactionCount();
     
     // Render summary
     int summaryY = window->getHeight() - 200;
     window->renderText("Summary:", 50, summaryY, window->getFont(), window->getPrimaryColor());
     summaryY += 25;
     
-    std::string totalDepositsStr = "Total Deposits: $" + std::to_string(static_cast<int>(totalDeposits));
-    std::string totalWithdrawalsStr = "Total Withdrawals: $" + std::to_string(static_cast<int>(totalWithdrawals));
+    std::string totalDepositsStr = "Total Deposits: " + totalDeposits.toString();
+    std::string totalWithdrawalsStr = "Total Withdrawals: " + totalWithdrawals.toString();
     std::string transactionCountStr = "Total Transactions: " + std::to_string(transactionCount);
     
     window->renderText(totalDepositsStr, 50, summaryY, window->getFont(), window->getSuccessColor());
     window->renderText(totalWithdrawalsStr, 250, summaryY, window->getFont(), window->getErrorColor());
     window->renderText(transactionCountStr, 450, summaryY, window->getFont(), window->getSecondaryColor());
+    
+    if (activity.hasActivity()) {
+        summaryY += 25;
+        std::string rangeStr = "Balance Range: " + activity.minBalance.toString() + " - " + activity.maxBalance.toString();
+        std::string countsStr = "Deposits: " + std::to_string(activity.countOf(TransactionType::DEPOSIT)) +
+                                "  Withdrawals: " + std::to_string(activity.countOf(TransactionType::WITHDRAWAL)) +
+                                "  Transfers: " + std::to_string(activity.countOf(TransactionType::TRANSFER));
+        window->renderText(rangeStr, 50, summaryY, window->getFont(), window->getSecondaryColor());
+        window->renderText(countsStr, 450, summaryY, window->getFont(), window->getSecondaryColor());
+    }
 }
 
 void TransactionScreen::handleBack() {
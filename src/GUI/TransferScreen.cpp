@@ -7,6 +7,8 @@
 #include <iostream>
 #include <sstream>
 #include <iomanip>
+#include <algorithm>
+#include <cctype>
 
 TransferScreen::TransferScreen(std::shared_ptr<Window> window, std::shared_ptr<Bank> bankSystem)
     : Screen(window, "Money Transfer"), bank(bankSystem), showError(false), showSuccess(false), messageTimer(0) {
@@ -26,22 +28,30 @@ void TransferScreen::render() {
     // Render account information
     auto currentUser = bank->getCurrentUser();
     if (currentUser) {
-        auto accounts = currentUser->getAccounts();
+        auto accounts = bank->getUserAccounts(*currentUser);
         if (!accounts.empty()) {
             std::string accountInfo = "Your accounts: ";
             for (size_t i = 0; i < accounts.size(); ++i) {
                 if (i > 0) accountInfo += ", ";
-                accountInfo += accounts[i]->getAccountNumber() + " ($" + std::to_string(static_cast<int>(accounts[i]->getBalance())) + ")";
+                accountInfo += accounts[i]->getAccountNumber() + " (" + accounts[i]->getFormattedBalance() + ")";
             }
             window->renderCenteredText(accountInfo, 120, window->getFont(), window->getSecondaryColor());
         }
     }
     
+    // Render destination suggestions next to the field
+    renderAccountSuggestions();
+    
     // Render messages
     renderMessages();
 }
 
 void TransferScreen::handleEvent(const SDL_Event& event) {
+    if (event.type == SDL_MOUSEBUTTONDOWN && event.button.button == SDL_BUTTON_LEFT &&
+        handleSuggestionClick(event.button.x, event.button.y)) {
+        return;
+    }
+    
     Screen::handleEvent(event);
     
     // Handle mouse movement for button hover effects
@@ -75,8 +85,11 @@ void TransferScreen::onEnter() {
     clearMessages();
     // Pre-fill from account with user's first account
     auto currentUser = bank->getCurrentUser();
-    if (currentUser && !currentUser->getAccounts().empty()) {
-        fromAccountField->setText(currentUser->getAccounts()[0]->getAccountNumber());
+    if (currentUser) {
+        auto accounts = bank->getUserAccounts(*currentUser);
+        if (!accounts.empty()) {
+            fromAccountField->setText(accounts[0]->getAccountNumber());
+        }
     }
 }
 
@@ -107,6 +120,10 @@ void TransferScreen::setupUI() {
     backButton = std::make_shared<Button>(centerX + spacing/2, startY + 4*(fieldHeight + spacing), buttonWidth, buttonHeight, "Back", "back");
     clearButton = std::make_shared<Button>(centerX - buttonWidth/2, startY + 5*(fieldHeight + spacing), buttonWidth, buttonHeight, "Clear", "clear");
     
+    // Suggest destination accounts as the number is typed
+    accountCursor = bank->accountNumberCursor();
+    toAccountField->setOnChange([this](const std::string& text) { updateAccountSuggestions(text); });
+    
     // Set up callbacks
     transferButton->setOnClick([this]() { handleTransfer(); });
     backButton->setOnClick([this]() { handleBack(); });
@@ -131,17 +148,15 @@ void TransferScreen::handleTransfer() {
     std::string description = descriptionField->getText();
     
     // Parse amount
-    double amount;
-    try {
-        amount = std::stod(amountStr);
-    } catch (const std::exception& e) {
+    Money amount;
+    if (!Money::parse(amountStr, amount)) {
         showErrorMessage("Invalid amount format");
         return;
     }
     
     // Perform transfer
-    if (bank->transfer(fromAccount, toAccount, amount)) {
-        showSuccessMessage("Transfer successful! Amount: $" + std::to_string(static_cast<int>(amount)));
+    if (bank->transfer(fromAccount, toAccount, amount, description)) {
+        showSuccessMessage("Transfer successful! Amount: " + amount.toString());
         amountField->clearText();
         toAccountField->clearText();
         descriptionField->clearText();
@@ -165,8 +180,11 @@ void TransferScreen::handleClear() {
     
     // Pre-fill from account again
     auto currentUser = bank->getCurrentUser();
-    if (currentUser && !currentUser->getAccounts().empty()) {
-        fromAccountField->setText(currentUser->getAccounts()[0]->getAccountNumber());
+    if (currentUser) {
+        auto accounts = bank->getUserAccounts(*currentUser);
+        if (!accounts.empty()) {
+            fromAccountField->setText(accounts[0]->getAccountNumber());
+        }
     }
 }
 
@@ -201,6 +219,65 @@ void TransferScreen::renderMessages() {
     }
 }
 
+void TransferScreen::updateAccountSuggestions(const std::string& text) {
+    accountSuggestions.clear();
+    if (text.empty()) {
+        accountCursor.update(text);
+        return;
+    }
+    
+    // Account numbers use upper-case type prefixes
+    std::string prefix(text);
+    std::transform(prefix.begin(), prefix.end(), prefix.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::toupper(c)); });
+    accountCursor.update(prefix);
+    
+    // Closed accounts cannot receive money, and the number already typed needs no suggestion
+    auto offered = [this, &prefix](AccountId accountId) {
+        const Account* account = bank->getAccount(accountId);
+        return account && account->getIsActive() && bank->getAccountNumber(accountId) != prefix;
+    };
+    for (AccountId accountId : accountCursor.suggestions(5, offered)) {
+        accountSuggestions.push_back(bank->getAccountNumber(accountId));
+    }
+}
+
+void TransferScreen::renderAccountSuggestions() {
+    if (!toAccountField || toAccountField->getText().empty()) return;
+    
+    int x = toAccountField->getX() + toAccountField->getWidth() + 10;
+    int y = toAccountField->getY();
+    int lineHeight = 20;
+    
+    if (accountSuggestions.empty()) {
+        if (!accountCursor.hasMatches()) {
+            window->renderText("No matching accounts", x, y, window->getSmallFont(), window->getErrorColor());
+        }
+        return;
+    }
+    
+    for (const auto& suggestion : accountSuggestions) {
+        window->renderText(suggestion, x, y, window->getSmallFont(), window->getSecondaryColor());
+        y += lineHeight;
+    }
+}
+
+bool TransferScreen::handleSuggestionClick(int mouseX, int mouseY) {
+    if (!toAccountField || accountSuggestions.empty()) return false;
+    
+    int x = toAccountField->getX() + toAccountField->getWidth() + 10;
+    int y = toAccountField->getY();
+    int lineHeight = 20;
+    
+    for (size_t i = 0; i < accountSuggestions.size(); ++i) {
+        if (isPointInRect(mouseX, mouseY, x, y + static_cast<int>(i) * lineHeight, 150, lineHeight)) {
+            toAccountField->setText(accountSuggestions[i]);
+            return true;
+        }
+    }
+    return false;
+}
+
 bool TransferScreen::validateInput() {
     if (fromAccountField->getText().empty()) {
         showErrorMessage("Please enter the source account number");
@@ -234,15 +311,7 @@ bool TransferScreen::validateInput() {
     // Check if user owns the source account
     auto currentUser = bank->getCurrentUser();
     if (currentUser) {
-        bool ownsAccount = false;
-        for (auto& account : currentUser->getAccounts()) {
-            if (account->getAccountNumber() == fromAccountField->getText()) {
-                ownsAccount = true;
-                break;
-            }
-        }
-        
-        if (!ownsAccount) {
+        if (!currentUser->ownsAccount(bank->getAccountHandle(fromAccount->getId()))) {
             showErrorMessage("You can only transfer from your own accounts");
             return false;
         }
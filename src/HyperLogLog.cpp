@@ -0,0 +1,51 @@
+#include "HyperLogLog.h"
+#include <cmath>
+
+void HyperLogLog::add(std::uint64_t value) {
+    std::uint64_t hash = mix(value);
+    std::size_t index = static_cast<std::size_t>(hash >> (64 - PRECISION));
+    
+    // Rank is the position of the first set bit after the index bits
+    std::uint64_t rest = hash << PRECISION;
+    std::uint8_t rank = 1;
+    while (rank <= 64 - PRECISION && (rest & (std::uint64_t(1) << 63)) == 0) {
+        ++rank;
+        rest <<= 1;
+    }
+    if (rank > registers[index]) {
+        registers[index] = rank;
+    }
+}
+
+void HyperLogLog::merge(const HyperLogLog& other) {
+    for (std::size_t i = 0; i < REGISTER_COUNT; ++i) {
+        if (other.registers[i] > registers[i]) {
+            registers[i] = other.registers[i];
+        }
+    }
+}
+
+std::uint64_t HyperLogLog::estimate() const {
+    double sum = 0.0;
+    std::size_t zeros = 0;
+    for (std::uint8_t value : registers) {
+        sum += std::ldexp(1.0, -static_cast<int>(value));
+        if (value == 0) ++zeros;
+    }
+    
+    double m = static_cast<double>(REGISTER_COUNT);
+    double alpha = 0.7213 / (1.0 + 1.079 / m);
+    double raw = alpha * m * m / sum;
+    if (raw <= 2.5 * m && zeros > 0) {
+        raw = m * std::log(m / static_cast<double>(zeros));
+    }
+    return static_cast<std::uint64_t>(std::llround(raw));
+}
+
+std::uint64_t HyperLogLog::mix(std::uint64_t value) {
+    // splitmix64 finalizer: dense ids come out uniformly spread
+    value += 0x9e3779b97f4a7c15ULL;
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+    return value ^ (value >> 31);
+}
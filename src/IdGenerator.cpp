@@ -0,0 +1,61 @@
+#include "IdGenerator.h"
+#include <atomic>
+
+struct IdBlock {
+    std::uint64_t next = 0;
+    std::uint64_t end = 0;
+};
+
+static constexpr std::size_t spaceCount = 3;
+
+// Account numbers and user ids keep the nine-digit range of the old random ids
+static std::atomic<std::uint64_t> nextBlockStart[spaceCount] = {{1}, {100000000}, {100000000}};
+static thread_local IdBlock blocks[spaceCount];
+
+std::uint64_t IdGenerator::next(IdSpace space) {
+    IdBlock& block = blocks[static_cast<std::size_t>(space)];
+    if (block.next == block.end) {
+        block.next = nextBlockStart[static_cast<std::size_t>(space)].fetch_add(blockSize, std::memory_order_relaxed);
+        block.end = block.next + blockSize;
+    }
+    return block.next++;
+}
+
+std::size_t IdGenerator::format(char* buffer, const char* prefix, std::uint64_t value, std::size_t width) {
+    std::size_t length = 0;
+    while (prefix[length] != '\0') {
+        buffer[length] = prefix[length];
+        ++length;
+    }
+    
+    // Fill digits from the right; values wider than width keep all their digits
+    char digits[20];
+    std::size_t count = 0;
+    do {
+        digits[count++] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    } while (value != 0);
+    
+    for (std::size_t pad = count; pad < width; ++pad) {
+        buffer[length++] = '0';
+    }
+    while (count > 0) {
+        buffer[length++] = digits[--count];
+    }
+    return length;
+}
+
+std::string IdGenerator::nextTransactionId() {
+    char buffer[32];
+    return std::string(buffer, format(buffer, "TXN", next(IdSpace::TRANSACTION), 12));
+}
+
+std::string IdGenerator::nextAccountNumber(const std::string& prefix) {
+    char buffer[32];
+    return std::string(buffer, format(buffer, prefix.c_str(), next(IdSpace::ACCOUNT), 9));
+}
+
+std::string IdGenerator::nextUserId() {
+    char buffer[32];
+    return std::string(buffer, format(buffer, "USR", next(IdSpace::USER), 9));
+}
@@ -0,0 +1,20 @@
+#include "Money.h"
+#include "TextFormat.h"
+#include <cmath>
+
+Money Money::fromDouble(double amount) {
+    return Money(static_cast<std::int64_t>(std::llround(amount * 100.0)));
+}
+
+bool Money::parse(const std::string& text, Money& result) {
+    return TextFormat::parseMoney(text.data(), text.data() + text.size(), result);
+}
+
+Money Money::scaledBy(double factor) const {
+    return Money(static_cast<std::int64_t>(std::llround(static_cast<double>(cents) * factor)));
+}
+
+std::string Money::toString() const {
+    char buffer[TextFormat::MONEY_BUFFER];
+    return std::string(buffer, TextFormat::formatMoney(buffer, *this));
+}
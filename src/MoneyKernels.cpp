@@ -0,0 +1,82 @@
+#include "MoneyKernels.h"
+#include <limits>
+
+Money MoneyKernels::sum(const Money* values, std::size_t count) {
+    std::int64_t totals[4] = {0, 0, 0, 0};
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        totals[0] += values[i].getCents();
+        totals[1] += values[i + 1].getCents();
+        totals[2] += values[i + 2].getCents();
+        totals[3] += values[i + 3].getCents();
+    }
+    for (; i < count; ++i) {
+        totals[0] += values[i].getCents();
+    }
+    return Money::fromCents(totals[0] + totals[1] + totals[2] + totals[3]);
+}
+
+Money MoneyKernels::min(const Money* values, std::size_t count) {
+    if (count == 0) {
+        return Money();
+    }
+    
+    std::int64_t lows[4];
+    for (auto& low : lows) low = std::numeric_limits<std::int64_t>::max();
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        for (std::size_t lane = 0; lane < 4; ++lane) {
+            std::int64_t value = values[i + lane].getCents();
+            lows[lane] = value < lows[lane] ? value : lows[lane];
+        }
+    }
+    for (; i < count; ++i) {
+        std::int64_t value = values[i].getCents();
+        lows[0] = value < lows[0] ? value : lows[0];
+    }
+    
+    std::int64_t result = lows[0];
+    for (std::int64_t low : lows) result = low < result ? low : result;
+    return Money::fromCents(result);
+}
+
+Money MoneyKernels::max(const Money* values, std::size_t count) {
+    if (count == 0) {
+        return Money();
+    }
+    
+    std::int64_t highs[4];
+    for (auto& high : highs) high = std::numeric_limits<std::int64_t>::min();
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        for (std::size_t lane = 0; lane < 4; ++lane) {
+            std::int64_t value = values[i + lane].getCents();
+            highs[lane] = value > highs[lane] ? value : highs[lane];
+        }
+    }
+    for (; i < count; ++i) {
+        std::int64_t value = values[i].getCents();
+        highs[0] = value > highs[0] ? value : highs[0];
+    }
+    
+    std::int64_t result = highs[0];
+    for (std::int64_t high : highs) result = high > result ? high : result;
+    return Money::fromCents(result);
+}
+
+std::vector<std::uint32_t> MoneyKernels::selectBetween(const Money* values, std::size_t count, Money low, Money high) {
+    // Write every index and advance the output only on a match, so the loop
+    // has no data-dependent branch; the buffer is trimmed afterwards
+    std::vector<std::uint32_t> selected(count);
+    std::int64_t lowCents = low.getCents();
+    std::int64_t highCents = high.getCents();
+    
+    std::size_t matches = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        std::int64_t value = values[i].getCents();
+        selected[matches] = static_cast<std::uint32_t>(i);
+        matches += (value >= lowCents) & (value <= highCents);
+    }
+    selected.resize(matches);
+    return selected;
+}
@@ -0,0 +1,105 @@
+#include "QuantileSketch.h"
+#include <cmath>
+
+static const double GAMMA = (1.0 + QuantileSketch::RELATIVE_ACCURACY) / (1.0 - QuantileSketch::RELATIVE_ACCURACY);
+static const double LOG_GAMMA = std::log(GAMMA);
+
+void QuantileSketch::add(Money value) {
+    std::int64_t cents = value.getCents();
+    if (cents == 0) {
+        ++zeroCount;
+    } else if (cents > 0) {
+        adjust(positive, keyOf(cents), true);
+    } else {
+        adjust(negative, keyOf(-cents), true);
+    }
+    ++total;
+}
+
+void QuantileSketch::remove(Money value) {
+    if (total == 0) {
+        return;
+    }
+    
+    std::int64_t cents = value.getCents();
+    if (cents == 0) {
+        if (zeroCount == 0) return;
+        --zeroCount;
+    } else {
+        std::vector<std::uint32_t>& buckets = cents > 0 ? positive : negative;
+        std::size_t key = keyOf(cents > 0 ? cents : -cents);
+        if (key >= buckets.size() || buckets[key] == 0) return;
+        adjust(buckets, key, false);
+    }
+    --total;
+}
+
+void QuantileSketch::merge(const QuantileSketch& other) {
+    if (other.positive.size() > positive.size()) positive.resize(other.positive.size(), 0);
+    if (other.negative.size() > negative.size()) negative.resize(other.negative.size(), 0);
+    for (std::size_t key = 0; key < other.positive.size(); ++key) {
+        positive[key] += other.positive[key];
+    }
+    for (std::size_t key = 0; key < other.negative.size(); ++key) {
+        negative[key] += other.negative[key];
+    }
+    zeroCount += other.zeroCount;
+    total += other.total;
+}
+
+void QuantileSketch::clear() {
+    positive.clear();
+    negative.clear();
+    zeroCount = 0;
+    total = 0;
+}
+
+Money QuantileSketch::quantile(double q) const {
+    if (total == 0) {
+        return Money();
+    }
+    
+    // Nearest rank: the smallest value with at least q of the population at or below it.
+    // Walk from the most negative bucket upwards until that rank is covered
+    q = q < 0.0 ? 0.0 : (q > 1.0 ? 1.0 : q);
+    double position = std::ceil(q * static_cast<double>(total));
+    std::uint64_t rank = position < 1.0 ? 0 : static_cast<std::uint64_t>(position) - 1;
+    rank = rank < total ? rank : total - 1;
+    std::uint64_t seen = 0;
+    for (std::size_t key = negative.size(); key > 0; --key) {
+        seen += negative[key - 1];
+        if (seen > rank) return valueOf(key - 1, true);
+    }
+    seen += zeroCount;
+    if (seen > rank) {
+        return Money();
+    }
+    for (std::size_t key = 0; key < positive.size(); ++key) {
+        seen += positive[key];
+        if (seen > rank) return valueOf(key, false);
+    }
+    return positive.empty() ? Money() : valueOf(positive.size() - 1, false);
+}
+
+std::size_t QuantileSketch::keyOf(std::int64_t magnitude) {
+    // Bucket k covers (GAMMA^(k-1), GAMMA^k]; one cent lands in bucket 0
+    return static_cast<std::size_t>(std::ceil(std::log(static_cast<double>(magnitude)) / LOG_GAMMA));
+}
+
+Money QuantileSketch::valueOf(std::size_t key, bool negated) {
+    // The bucket's midpoint in relative terms keeps the error symmetric
+    double magnitude = 2.0 * std::pow(GAMMA, static_cast<double>(key)) / (GAMMA + 1.0);
+    std::int64_t cents = static_cast<std::int64_t>(std::llround(magnitude));
+    return Money::fromCents(negated ? -cents : cents);
+}
+
+void QuantileSketch::adjust(std::vector<std::uint32_t>& buckets, std::size_t key, bool increment) {
+    if (key >= buckets.size()) {
+        buckets.resize(key + 1, 0);
+    }
+    if (increment) {
+        ++buckets[key];
+    } else {
+        --buckets[key];
+    }
+}
@@ -0,0 +1,117 @@
+#include "SlabArena.h"
+
+SlabArena::SlabArena(std::size_t slabBytes)
+    : slabSize(slabBytes < minBlockSize ? minBlockSize : slabBytes), currentSlab(0), offset(0) {
+    for (auto& list : freeLists) list = nullptr;
+}
+
+SlabArena::~SlabArena() {
+    release();
+}
+
+void* SlabArena::allocate(std::size_t bytes) {
+    std::size_t index = sizeClass(bytes);
+    std::size_t blockSize = minBlockSize << index;
+    if (blockSize < bytes) {
+        throw std::bad_alloc();
+    }
+    ++stats.allocations;
+    stats.bytesInUse += blockSize;
+    if (blockSize > slabSize) {
+        ++stats.largeBlocks;
+    }
+    
+    if (FreeBlock* block = freeLists[index]) {
+        freeLists[index] = block->next;
+        ++stats.recycled;
+        return block;
+    }
+    return blockSize > slabSize ? allocateLarge(index) : bump(blockSize);
+}
+
+void SlabArena::deallocate(void* block, std::size_t bytes) {
+    if (!block) {
+        return;
+    }
+    
+    std::size_t index = sizeClass(bytes);
+    std::size_t blockSize = minBlockSize << index;
+    if (blockSize > slabSize) {
+        --stats.largeBlocks;
+    }
+    
+    FreeBlock* freed = static_cast<FreeBlock*>(block);
+    freed->next = freeLists[index];
+    freeLists[index] = freed;
+    stats.bytesInUse -= blockSize;
+}
+
+void SlabArena::reset() {
+    // Keep the slabs; the next allocations bump through them again
+    currentSlab = 0;
+    offset = 0;
+    for (auto& list : freeLists) list = nullptr;
+    
+    // Every block is free again, so large blocks go straight back on their lists
+    for (const LargeBlock& large : largeBlocks) {
+        FreeBlock* freed = reinterpret_cast<FreeBlock*>(large.memory);
+        freed->next = freeLists[large.sizeClass];
+        freeLists[large.sizeClass] = freed;
+    }
+    stats.bytesInUse = 0;
+    stats.largeBlocks = 0;
+}
+
+void SlabArena::release() {
+    for (unsigned char* slab : slabs) {
+        ::operator delete(slab);
+    }
+    slabs.clear();
+    for (const LargeBlock& large : largeBlocks) {
+        ::operator delete(large.memory);
+    }
+    largeBlocks.clear();
+    reset();
+    stats.slabCount = 0;
+    stats.bytesReserved = 0;
+}
+
+std::size_t SlabArena::sizeClass(std::size_t bytes) {
+    std::size_t index = 0;
+    std::size_t blockSize = minBlockSize;
+    while (blockSize < bytes && index + 1 < classCount) {
+        blockSize <<= 1;
+        ++index;
+    }
+    return index;
+}
+
+void* SlabArena::bump(std::size_t bytes) {
+    // Block sizes are powers of two no larger than a slab, so an aligned
+    // offset stays aligned and a fresh slab always has room
+    if (currentSlab < slabs.size() && offset + bytes > slabSize) {
+        ++currentSlab;
+        offset = 0;
+    }
+    if (currentSlab == slabs.size()) {
+        slabs.push_back(static_cast<unsigned char*>(::operator new(slabSize)));
+        ++stats.slabCount;
+        ++stats.heapAllocations;
+        stats.bytesReserved += slabSize;
+        offset = 0;
+    }
+    
+    void* block = slabs[currentSlab] + offset;
+    offset += bytes;
+    return block;
+}
+
+void* SlabArena::allocateLarge(std::size_t index) {
+    // Too big for a slab: take a block of exactly its class from the heap and keep it
+    std::size_t blockSize = minBlockSize << index;
+    unsigned char* memory = static_cast<unsigned char*>(::operator new(blockSize));
+    largeBlocks.push_back(LargeBlock{memory, index});
+    ++stats.heapAllocations;
+    stats.bytesReserved += blockSize;
+    return memory;
+}
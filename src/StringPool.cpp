@@ -0,0 +1,24 @@
+#include "StringPool.h"
+
+StringId StringPool::intern(const std::string& text) {
+    if (text.empty()) {
+        return EMPTY_STRING_ID;
+    }
+    if (const StringId* existing = idsByText.find(text)) {
+        return *existing;
+    }
+    
+    StringId id = static_cast<StringId>(strings.size());
+    strings.push_back(text);
+    idsByText.insert(text, id);
+    return id;
+}
+
+const std::string& StringPool::textOf(StringId id) const {
+    return id < strings.size() ? strings[id] : strings[EMPTY_STRING_ID];
+}
+
+void StringPool::clear() {
+    strings.assign(1, std::string());
+    idsByText.clear();
+}
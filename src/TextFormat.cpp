@@ -0,0 +1,246 @@
+#include "TextFormat.h"
+#include <atomic>
+#include <charconv>
+#include <ctime>
+#include <limits>
+#include <mutex>
+
+static constexpr std::int64_t SECONDS_PER_DAY = 86400;
+
+// Offsets are cached per quarter hour of UTC. A period whose first and last
+// second disagree holds a transition and is never cached
+static constexpr std::int64_t OFFSET_PERIOD = 15 * 60;
+static constexpr std::size_t OFFSET_SLOTS = 256;
+static constexpr std::int64_t OFFSET_BIAS = std::int64_t(1) << 23;
+static constexpr std::uint64_t OFFSET_MASK = (std::uint64_t(1) << 24) - 1;
+
+// Each slot packs (period + 1) above a biased 24-bit offset; zero is empty
+static std::atomic<std::uint64_t> offsetTable[OFFSET_SLOTS];
+static std::mutex localtimeMutex;
+
+static std::int64_t floorDiv(std::int64_t value, std::int64_t divisor) {
+    std::int64_t quotient = value / divisor;
+    return (value % divisor != 0 && (value < 0) != (divisor < 0)) ? quotient - 1 : quotient;
+}
+
+static std::int64_t secondsOf(std::chrono::system_clock::time_point time) {
+    return std::chrono::floor<std::chrono::seconds>(time.time_since_epoch()).count();
+}
+
+// Days since 1970-01-01 in the proleptic Gregorian calendar; day may overflow its month
+static std::int64_t daysFromCivil(std::int64_t year, int month, int day) {
+    year -= month <= 2;
+    std::int64_t era = floorDiv(year, 400);
+    std::int64_t yearOfEra = year - era * 400;
+    std::int64_t dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    std::int64_t dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + dayOfEra - 719468;
+}
+
+static void civilFromDays(std::int64_t days, LocalTime& local) {
+    days += 719468;
+    std::int64_t era = floorDiv(days, 146097);
+    std::int64_t dayOfEra = days - era * 146097;
+    std::int64_t yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    std::int64_t dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    std::int64_t shiftedMonth = (5 * dayOfYear + 2) / 153;
+    local.day = static_cast<int>(dayOfYear - (153 * shiftedMonth + 2) / 5 + 1);
+    local.month = static_cast<int>(shiftedMonth < 10 ? shiftedMonth + 3 : shiftedMonth - 9);
+    local.year = static_cast<int>(yearOfEra + era * 400 + (local.month <= 2));
+}
+
+static std::int64_t queryOffset(std::int64_t seconds) {
+    // std::localtime shares one static buffer, so callers take turns
+    std::time_t time = static_cast<std::time_t>(seconds);
+    std::tm local;
+    {
+        std::lock_guard<std::mutex> lock(localtimeMutex);
+        const std::tm* converted = std::localtime(&time);
+        if (!converted) {
+            return 0;
+        }
+        local = *converted;
+    }
+    std::int64_t localSeconds = daysFromCivil(local.tm_year + 1900, local.tm_mon + 1, local.tm_mday) * SECONDS_PER_DAY +
+                                local.tm_hour * 3600 + local.tm_min * 60 + local.tm_sec;
+    return localSeconds - seconds;
+}
+
+static std::int64_t offsetAtSeconds(std::int64_t seconds) {
+    std::int64_t period = floorDiv(seconds, OFFSET_PERIOD);
+    std::uint64_t tag = static_cast<std::uint64_t>(period + 1) << 24;
+    std::atomic<std::uint64_t>& slot = offsetTable[static_cast<std::uint64_t>(period) % OFFSET_SLOTS];
+    
+    std::uint64_t entry = slot.load(std::memory_order_relaxed);
+    if (entry != 0 && (entry & ~OFFSET_MASK) == tag) {
+        return static_cast<std::int64_t>(entry & OFFSET_MASK) - OFFSET_BIAS;
+    }
+    
+    std::int64_t start = period * OFFSET_PERIOD;
+    std::int64_t offset = queryOffset(start);
+    if (queryOffset(start + OFFSET_PERIOD - 1) != offset) {
+        return queryOffset(seconds);
+    }
+    slot.store(tag | static_cast<std::uint64_t>(offset + OFFSET_BIAS), std::memory_order_relaxed);
+    return offset;
+}
+
+// Fixed-width zero-padded digits
+static char* writeDigits(char* out, std::uint64_t value, int width) {
+    for (int i = width - 1; i >= 0; --i) {
+        out[i] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    }
+    return out + width;
+}
+
+// "YYYY-MM-DD"; system_clock's range keeps the year within four digits
+static char* writeDate(char* out, const LocalTime& local) {
+    out = writeDigits(out, static_cast<std::uint64_t>(local.year), 4);
+    *out++ = '-';
+    out = writeDigits(out, static_cast<std::uint64_t>(local.month), 2);
+    *out++ = '-';
+    return writeDigits(out, static_cast<std::uint64_t>(local.day), 2);
+}
+
+// Between one and maxDigits digits, then the end of input or the expected separator
+static bool readField(const char*& cursor, const char* last, int maxDigits, char separator, int& value) {
+    std::from_chars_result parsed = std::from_chars(cursor, last, value);
+    if (parsed.ec != std::errc() || *cursor == '-' || parsed.ptr - cursor > maxDigits) {
+        return false;
+    }
+    cursor = parsed.ptr;
+    if (separator != '\0') {
+        if (cursor == last || *cursor != separator) return false;
+        ++cursor;
+    }
+    return true;
+}
+
+std::size_t TextFormat::formatMoney(char* buffer, Money amount) {
+    // Negate through unsigned so the minimum value does not overflow
+    std::int64_t cents = amount.getCents();
+    std::uint64_t magnitude = cents < 0 ? 0 - static_cast<std::uint64_t>(cents) : static_cast<std::uint64_t>(cents);
+    
+    char* out = buffer;
+    if (cents < 0) *out++ = '-';
+    *out++ = '$';
+    out = std::to_chars(out, buffer + MONEY_BUFFER, magnitude / 100).ptr;
+    *out++ = '.';
+    out = writeDigits(out, magnitude % 100, 2);
+    *out = '\0';
+    return static_cast<std::size_t>(out - buffer);
+}
+
+std::size_t TextFormat::formatTimestamp(char* buffer, std::chrono::system_clock::time_point time) {
+    LocalTime local = toLocal(time);
+    char* out = writeDate(buffer, local);
+    *out++ = ' ';
+    out = writeDigits(out, static_cast<std::uint64_t>(local.hour), 2);
+    *out++ = ':';
+    out = writeDigits(out, static_cast<std::uint64_t>(local.minute), 2);
+    *out++ = ':';
+    out = writeDigits(out, static_cast<std::uint64_t>(local.second), 2);
+    *out = '\0';
+    return static_cast<std::size_t>(out - buffer);
+}
+
+std::size_t TextFormat::formatDate(char* buffer, std::chrono::system_clock::time_point time) {
+    char* out = writeDate(buffer, toLocal(time));
+    *out = '\0';
+    return static_cast<std::size_t>(out - buffer);
+}
+
+bool TextFormat::parseMoney(const char* first, const char* last, Money& result) {
+    // Accepts "12", "12.3", "12.34" with an optional leading '$'; no sign, exponent
+    // or extra digits, so the value is read exactly instead of through a double
+    const char* cursor = first;
+    if (cursor != last && *cursor == '$') ++cursor;
+    
+    std::uint64_t dollars = 0;
+    bool hasDollars = false;
+    if (cursor != last && *cursor >= '0' && *cursor <= '9') {
+        std::from_chars_result parsed = std::from_chars(cursor, last, dollars);
+        if (parsed.ec != std::errc()) return false;
+        cursor = parsed.ptr;
+        hasDollars = true;
+    }
+    
+    std::int64_t fraction = 0;
+    std::size_t fractionDigits = 0;
+    if (cursor != last && *cursor == '.') {
+        ++cursor;
+        while (cursor != last && *cursor >= '0' && *cursor <= '9') {
+            if (++fractionDigits > 2) return false;
+            fraction = fraction * 10 + (*cursor - '0');
+            ++cursor;
+        }
+    }
+    
+    if (cursor != last || (!hasDollars && fractionDigits == 0)) return false;
+    if (dollars > static_cast<std::uint64_t>((std::numeric_limits<std::int64_t>::max() - 99) / 100)) return false;
+    if (fractionDigits == 1) fraction *= 10;
+    
+    result = Money::fromCents(static_cast<std::int64_t>(dollars) * 100 + fraction);
+    return true;
+}
+
+bool TextFormat::parseLocalTime(const char* first, const char* last, LocalTime& result) {
+    // "YYYY-MM-DD" optionally followed by " HH:MM:SS"
+    LocalTime parsed;
+    const char* cursor = first;
+    if (!readField(cursor, last, 4, '-', parsed.year) ||
+        !readField(cursor, last, 2, '-', parsed.month) ||
+        !readField(cursor, last, 2, '\0', parsed.day)) {
+        return false;
+    }
+    if (cursor != last) {
+        if (*cursor != ' ') return false;
+        ++cursor;
+        if (!readField(cursor, last, 2, ':', parsed.hour) ||
+            !readField(cursor, last, 2, ':', parsed.minute) ||
+            !readField(cursor, last, 2, '\0', parsed.second) ||
+            cursor != last) {
+            return false;
+        }
+    }
+    
+    if (parsed.month < 1 || parsed.month > 12 || parsed.day < 1 || parsed.day > 31 ||
+        parsed.hour > 23 || parsed.minute > 59 || parsed.second > 60) {
+        return false;
+    }
+    result = parsed;
+    return true;
+}
+
+LocalTime TextFormat::toLocal(std::chrono::system_clock::time_point time) {
+    std::int64_t seconds = secondsOf(time);
+    seconds += offsetAtSeconds(seconds);
+    
+    LocalTime local;
+    std::int64_t days = floorDiv(seconds, SECONDS_PER_DAY);
+    std::int64_t secondOfDay = seconds - days * SECONDS_PER_DAY;
+    civilFromDays(days, local);
+    local.hour = static_cast<int>(secondOfDay / 3600);
+    local.minute = static_cast<int>(secondOfDay / 60 % 60);
+    local.second = static_cast<int>(secondOfDay % 60);
+    return local;
+}
+
+std::chrono::system_clock::time_point TextFormat::fromLocal(const LocalTime& local) {
+    std::int64_t monthIndex = static_cast<std::int64_t>(local.year) * 12 + (local.month - 1);
+    std::int64_t year = floorDiv(monthIndex, 12);
+    int month = static_cast<int>(monthIndex - year * 12) + 1;
+    std::int64_t localSeconds = daysFromCivil(year, month, local.day) * SECONDS_PER_DAY +
+                                static_cast<std::int64_t>(local.hour) * 3600 + local.minute * 60 + local.second;
+    
+    // The offset depends on the answer; two rounds settle it outside DST gaps
+    std::int64_t guess = localSeconds - offsetAtSeconds(localSeconds);
+    std::int64_t seconds = localSeconds - offsetAtSeconds(guess);
+    return std::chrono::system_clock::time_point(
+        std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::seconds(seconds)));
+}
+
+std::int64_t TextFormat::utcOffsetAt(std::chrono::system_clock::time_point time) {
+    return offsetAtSeconds(secondsOf(time));
+}
@@ -0,0 +1,172 @@
+#include "TimeSeriesRollup.h"
+#include <algorithm>
+
+static std::int64_t secondsOf(std::chrono::system_clock::time_point time) {
+    return std::chrono::duration_cast<std::chrono::seconds>(time.time_since_epoch()).count();
+}
+
+TimeSeriesRollup::TimeSeriesRollup() {
+    rings[static_cast<std::size_t>(Resolution::MINUTE)].widthSeconds = 60;
+    rings[static_cast<std::size_t>(Resolution::MINUTE)].capacity = 24 * 60;
+    rings[static_cast<std::size_t>(Resolution::HOUR)].widthSeconds = 60 * 60;
+    rings[static_cast<std::size_t>(Resolution::HOUR)].capacity = 24 * 92;
+    rings[static_cast<std::size_t>(Resolution::DAY)].widthSeconds = 24 * 60 * 60;
+    rings[static_cast<std::size_t>(Resolution::DAY)].capacity = 5 * 366;
+}
+
+void TimeSeriesRollup::record(std::chrono::system_clock::time_point time, Money amount) {
+    std::int64_t seconds = secondsOf(time);
+    for (Ring& ring : rings) {
+        Slot& slot = ring.slotFor(seconds);
+        slot.volume += amount;
+        ++slot.count;
+    }
+}
+
+void TimeSeriesRollup::recordAssets(std::chrono::system_clock::time_point time, Money change) {
+    std::int64_t seconds = secondsOf(time);
+    for (Ring& ring : rings) {
+        ring.slotFor(seconds).assetChange += change;
+    }
+    assets += change;
+}
+
+void TimeSeriesRollup::clear() {
+    for (Ring& ring : rings) {
+        ring.clear();
+    }
+    assets = Money();
+}
+
+std::vector<TimeSeriesRollup::Point> TimeSeriesRollup::series(const Parts& parts, Resolution resolution,
+                                                              std::chrono::system_clock::time_point from,
+                                                              std::chrono::system_clock::time_point to) {
+    std::vector<Point> result;
+    if (parts.empty()) {
+        return result;
+    }
+    const Ring& shape = parts.front()->ringFor(resolution);
+    std::int64_t newest = -1;
+    Money closing;
+    for (const TimeSeriesRollup* part : parts) {
+        newest = std::max(newest, part->ringFor(resolution).newest);
+        closing += part->assets;
+    }
+    if (newest < 0) {
+        return result;
+    }
+    
+    // Buckets overlapping [from, to) within the window that ends at the newest one
+    std::int64_t width = shape.widthSeconds;
+    std::int64_t fromSeconds = secondsOf(from);
+    std::int64_t toSeconds = secondsOf(to);
+    std::int64_t oldest = std::max(newest - shape.capacity + 1, fromSeconds / width);
+    std::int64_t latest = std::min(newest, toSeconds > 0 ? (toSeconds - 1) / width : -1);
+    
+    // Walk back from the newest bucket: each closes at the total less every later change
+    for (std::int64_t bucket = newest; bucket >= oldest; --bucket) {
+        Point point;
+        bool seen = false;
+        Money change;
+        for (const TimeSeriesRollup* part : parts) {
+            if (const Slot* slot = part->ringFor(resolution).find(bucket)) {
+                seen = true;
+                change += slot->assetChange;
+                point.volume += slot->volume;
+                point.count += slot->count;
+            }
+        }
+        if (seen && bucket <= latest) {
+            point.start = std::chrono::system_clock::time_point(std::chrono::seconds(bucket * width));
+            point.width = std::chrono::seconds(width);
+            point.closingAssets = closing;
+            result.push_back(point);
+        }
+        closing -= change;
+    }
+    std::reverse(result.begin(), result.end());
+    return result;
+}
+
+std::vector<TimeSeriesRollup::Point> TimeSeriesRollup::chart(const Parts& parts,
+                                                             std::chrono::system_clock::time_point from,
+                                                             std::chrono::system_clock::time_point to,
+                                                             std::size_t maxPoints) {
+    // Prefer the finest ring whose window reaches back to from, or to the first bucket recorded
+    Resolution resolution = Resolution::DAY;
+    std::int64_t fromSeconds = secondsOf(from);
+    std::int64_t span = std::chrono::duration_cast<std::chrono::seconds>(to - from).count();
+    for (Resolution candidate : {Resolution::MINUTE, Resolution::HOUR}) {
+        std::int64_t newest = -1;
+        std::int64_t first = -1;
+        for (const TimeSeriesRollup* part : parts) {
+            const Ring& ring = part->ringFor(candidate);
+            if (ring.newest >= 0) {
+                newest = std::max(newest, ring.newest);
+                first = first < 0 ? ring.first : std::min(first, ring.first);
+            }
+        }
+        if (newest < 0) {
+            continue;
+        }
+        const Ring& shape = parts.front()->ringFor(candidate);
+        std::int64_t windowStart = newest - shape.capacity + 1;
+        bool covers = windowStart <= std::max(first, fromSeconds / shape.widthSeconds);
+        if (covers && span / shape.widthSeconds <= static_cast<std::int64_t>(maxPoints)) {
+            resolution = candidate;
+            break;
+        }
+    }
+    
+    std::vector<Point> points = series(parts, resolution, from, to);
+    if (maxPoints == 0 || points.size() <= maxPoints) {
+        return points;
+    }
+    
+    // Merge runs of neighbouring buckets; the run's last bucket closes it
+    std::size_t group = (points.size() + maxPoints - 1) / maxPoints;
+    std::vector<Point> merged;
+    for (std::size_t first = 0; first < points.size(); first += group) {
+        std::size_t last = std::min(points.size(), first + group);
+        Point point = points[first];
+        for (std::size_t i = first + 1; i < last; ++i) {
+            point.closingAssets = points[i].closingAssets;
+            point.volume += points[i].volume;
+            point.count += points[i].count;
+        }
+        point.width = std::chrono::duration_cast<std::chrono::seconds>(points[last - 1].start - point.start) + points[last - 1].width;
+        merged.push_back(point);
+    }
+    return merged;
+}
+
+TimeSeriesRollup::Slot& TimeSeriesRollup::Ring::slotFor(std::int64_t seconds) {
+    // Rows never go back in time, so anything older folds into the newest bucket
+    std::int64_t bucket = std::max(std::max<std::int64_t>(seconds, 0) / widthSeconds, newest);
+    if (slots.empty()) {
+        slots.resize(static_cast<std::size_t>(capacity));
+        first = bucket;
+    }
+    
+    Slot& slot = slots[static_cast<std::size_t>(bucket % capacity)];
+    if (slot.bucket != bucket) {
+        slot = Slot();
+        slot.bucket = bucket;
+    }
+    newest = bucket;
+    return slot;
+}
+
+const TimeSeriesRollup::Slot* TimeSeriesRollup::Ring::find(std::int64_t bucket) const {
+    if (slots.empty() || bucket < 0) {
+        return nullptr;
+    }
+    const Slot& slot = slots[static_cast<std::size_t>(bucket % capacity)];
+    return slot.bucket == bucket ? &slot : nullptr;
+}
+
+void TimeSeriesRollup::Ring::clear() {
+    slots.clear();
+    first = -1;
+    newest = -1;
+}
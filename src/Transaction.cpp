@@ -1,30 +1,81 @@
 #include "Transaction.h"
-#include <random>
-#include <sstream>
-#include <iomanip>
+#include "TransactionLedger.h"
+#include "TextFormat.h"
 #include <chrono>
-#include <ctime>
 
-Transaction::Transaction(TransactionType transType, double transAmount, 
-                       const std::string& desc, const std::string& fromAcc,
-                       const std::string& toAcc, double balanceAfterTrans)
-    : type(transType), amount(transAmount), description(desc), 
-      fromAccount(fromAcc), toAccount(toAcc), balanceAfter(balanceAfterTrans) {
-    generateTransactionId();
-    timestamp = std::chrono::system_clock::now();
+Transaction::Transaction(const TransactionLedger& source, std::size_t rowIndex, AccountId viewedFrom)
+    : ledger(&source), row(rowIndex), perspective(viewedFrom) {
 }
 
-void Transaction::generateTransactionId() {
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<long long> dis(100000000000LL, 999999999999LL);
+std::string Transaction::getTransactionId() const {
+    return ledger->transactionIdAt(row);
+}
+
+TransactionType Transaction::getType() const {
+    return ledger->typeAt(row);
+}
+
+Money Transaction::getAmount() const {
+    return ledger->amountAt(row);
+}
+
+std::string Transaction::getDescription() const {
+    const std::string& description = ledger->descriptionAt(row);
+    if (!description.empty()) {
+        return description;
+    }
     
-    std::ostringstream oss;
-    oss << "TXN" << std::setw(12) << std::setfill('0') << dis(gen);
-    transactionId = oss.str();
+    // Rows recorded without a description get the standard text for their type
+    switch (getType()) {
+        case TransactionType::DEPOSIT: return "Deposit";
+        case TransactionType::WITHDRAWAL: return "Withdrawal";
+        case TransactionType::INTEREST: return "Interest earned";
+        case TransactionType::FEE: return "Fee";
+        case TransactionType::TRANSFER:
+            if (perspective != INVALID_ACCOUNT_ID && perspective == getFromAccountId()) {
+                return "Transfer to " + getToAccount();
+            }
+            if (perspective != INVALID_ACCOUNT_ID && perspective == getToAccountId()) {
+                return "Transfer from " + getFromAccount();
+            }
+            return "Transfer";
+        default: return "";
+    }
+}
+
+std::chrono::system_clock::time_point Transaction::getTimestamp() const {
+    return ledger->timestampAt(row);
+}
+
+std::string Transaction::getFromAccount() const {
+    return ledger->fromAccountAt(row);
+}
+
+std::string Transaction::getToAccount() const {
+    return ledger->toAccountAt(row);
+}
+
+AccountId Transaction::getFromAccountId() const {
+    return ledger->fromAccountIdAt(row);
+}
+
+AccountId Transaction::getToAccountId() const {
+    return ledger->toAccountIdAt(row);
+}
+
+Money Transaction::getBalanceAfter() const {
+    // Without a perspective, report the paying side when there is one
+    AccountId fromAccount = getFromAccountId();
+    bool fromSide = perspective == INVALID_ACCOUNT_ID ? fromAccount != INVALID_ACCOUNT_ID
+                                                      : perspective == fromAccount;
+    return fromSide ? ledger->fromBalanceAfterAt(row) : ledger->toBalanceAfterAt(row);
 }
 
 std::string Transaction::getTypeString() const {
+    return typeToString(getType());
+}
+
+std::string Transaction::typeToString(TransactionType type) {
     switch (type) {
         case TransactionType::DEPOSIT: return "Deposit";
         case TransactionType::WITHDRAWAL: return "Withdrawal";
@@ -36,22 +87,14 @@ std::string Transaction::getTypeString() const {
 }
 
 std::string Transaction::getFormattedAmount() const {
-    std::ostringstream oss;
-    oss << std::fixed << std::setprecision(2) << "$" << amount;
-    return oss.str();
+    return getAmount().toString();
 }
 
 std::string Transaction::getFormattedTimestamp() const {
-    auto time_t = std::chrono::system_clock::to_time_t(timestamp);
-    std::tm* tm = std::localtime(&time_t);
-    
-    std::ostringstream oss;
-    oss << std::put_time(tm, "%Y-%m-%d %H:%M:%S");
-    return oss.str();
+    char buffer[TextFormat::TIMESTAMP_BUFFER];
+    return std::string(buffer, TextFormat::formatTimestamp(buffer, getTimestamp()));
 }
 
 std::string Transaction::getFormattedBalanceAfter() const {
-    std::ostringstream oss;
-    oss << std::fixed << std::setprecision(2) << "$" << balanceAfter;
-    return oss.str();
-} 
\ No newline at end of file
+    return getBalanceAfter().toString();
+}
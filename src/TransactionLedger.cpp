@@ -0,0 +1,443 @@
+#include "TransactionLedger.h"
+#include "MoneyKernels.h"
+#include "IdGenerator.h"
+#include "TextFormat.h"
+#include <algorithm>
+#include <unordered_map>
+
+TransactionLedger::TransactionLedger()
+    : transactionIds(ArenaAllocator<std::string>(arena)),
+      types(ArenaAllocator<TransactionType>(arena)),
+      amounts(ArenaAllocator<Money>(arena)),
+      timestamps(ArenaAllocator<std::chrono::system_clock::rep>(arena)),
+      fromAccounts(ArenaAllocator<AccountId>(arena)),
+      toAccounts(ArenaAllocator<AccountId>(arena)),
+      fromBalancesAfter(ArenaAllocator<Money>(arena)),
+      toBalancesAfter(ArenaAllocator<Money>(arena)),
+      descriptionIds(ArenaAllocator<StringId>(arena)),
+      postings(ArenaAllocator<RowList>(arena)),
+      activity(ArenaAllocator<AccountActivity>(arena)),
+      typeRows(ArenaAllocator<RowList>(arena)),
+      amountBuckets(ArenaAllocator<RowList>(arena)),
+      accountRegistry(nullptr) {
+}
+
+std::size_t TransactionLedger::append(TransactionType type, Money amount, const std::string& description,
+                                      AccountId fromAccount, AccountId toAccount,
+                                      Money fromBalanceAfter, Money toBalanceAfter) {
+    // Clamp against clock adjustments so the column stays sorted
+    std::chrono::system_clock::rep now = std::chrono::system_clock::now().time_since_epoch().count();
+    if (!timestamps.empty()) {
+        now = std::max(now, timestamps.back());
+    }
+    return appendRow(IdGenerator::nextTransactionId(), type, amount, now, description,
+                     fromAccount, toAccount, fromBalanceAfter, toBalanceAfter);
+}
+
+std::size_t TransactionLedger::appendRow(const std::string& transactionId, TransactionType type, Money amount,
+                                         std::chrono::system_clock::rep timestamp, const std::string& description,
+                                         AccountId fromAccount, AccountId toAccount,
+                                         Money fromBalanceAfter, Money toBalanceAfter) {
+    std::size_t row = types.size();
+    
+    transactionIds.push_back(transactionId);
+    types.push_back(type);
+    amounts.push_back(amount);
+    timestamps.push_back(timestamp);
+    fromAccounts.push_back(fromAccount);
+    toAccounts.push_back(toAccount);
+    fromBalancesAfter.push_back(fromBalanceAfter);
+    toBalancesAfter.push_back(toBalanceAfter);
+    descriptionIds.push_back(descriptionTexts.intern(description));
+    
+    // Index the row once for each account it touches
+    if (fromAccount != INVALID_ACCOUNT_ID) {
+        addRow(postings, fromAccount, row);
+        recordActivity(fromAccount, type, amount, timestamps.back(), fromBalanceAfter, toAccount);
+    }
+    if (toAccount != INVALID_ACCOUNT_ID && toAccount != fromAccount) {
+        addRow(postings, toAccount, row);
+        recordActivity(toAccount, type, amount, timestamps.back(), toBalanceAfter, fromAccount);
+    }
+    addRow(typeRows, static_cast<std::size_t>(type), row);
+    addRow(amountBuckets, amountBucketOf(amount), row);
+    
+    return row;
+}
+
+void TransactionLedger::reserve(std::size_t rows) {
+    transactionIds.reserve(rows);
+    types.reserve(rows);
+    amounts.reserve(rows);
+    timestamps.reserve(rows);
+    fromAccounts.reserve(rows);
+    toAccounts.reserve(rows);
+    fromBalancesAfter.reserve(rows);
+    toBalancesAfter.reserve(rows);
+    descriptionIds.reserve(rows);
+}
+
+void TransactionLedger::clear() {
+    // Hand every block back, then rewind the arena while keeping its slabs
+    releaseColumn(transactionIds);
+    releaseColumn(types);
+    releaseColumn(amounts);
+    releaseColumn(timestamps);
+    releaseColumn(fromAccounts);
+    releaseColumn(toAccounts);
+    releaseColumn(fromBalancesAfter);
+    releaseColumn(toBalancesAfter);
+    releaseColumn(descriptionIds);
+    releaseColumn(postings);
+    releaseColumn(activity);
+    releaseColumn(typeRows);
+    releaseColumn(amountBuckets);
+    descriptionTexts.clear();
+    arena.reset();
+}
+
+void TransactionLedger::openAccount(AccountId accountId, Money openingBalance) {
+    activityFor(accountId).includeBalance(openingBalance);
+}
+
+TransactionLedger::FoldResult TransactionLedger::foldInterest(std::chrono::system_clock::time_point cutoff) {
+    struct Group {
+        Money amount;
+        std::uint32_t count = 0;
+        std::size_t lastRow = 0;
+    };
+    static const std::uint32_t NO_GROUP = static_cast<std::uint32_t>(-1);
+    
+    // Group old interest credits by account and local calendar month
+    std::chrono::system_clock::rep limit = cutoff.time_since_epoch().count();
+    std::size_t rowCount = size();
+    std::vector<std::uint32_t> groupOf(rowCount, NO_GROUP);
+    std::vector<Group> groups;
+    std::unordered_map<std::uint64_t, std::uint32_t> groupIds;
+    for (std::uint32_t row : rowsOf(typeRows, static_cast<std::size_t>(TransactionType::INTEREST))) {
+        if (timestamps[row] >= limit) break;
+        if (toAccounts[row] == INVALID_ACCOUNT_ID) continue;
+        
+        LocalTime local = TextFormat::toLocal(timestampAt(row));
+        int month = local.year * 12 + local.month - 1;
+        std::uint64_t key = static_cast<std::uint64_t>(toAccounts[row]) << 32 | static_cast<std::uint32_t>(month);
+        
+        auto inserted = groupIds.emplace(key, static_cast<std::uint32_t>(groups.size()));
+        if (inserted.second) {
+            groups.push_back(Group());
+        }
+        Group& group = groups[inserted.first->second];
+        group.amount += amounts[row];
+        ++group.count;
+        group.lastRow = row;
+        groupOf[row] = inserted.first->second;
+    }
+    
+    FoldResult result;
+    for (const Group& group : groups) {
+        if (group.count > 1) {
+            result.rowsFolded += group.count;
+            ++result.summariesWritten;
+        }
+    }
+    if (result.summariesWritten == 0) {
+        return result;
+    }
+    
+    // Copy out the surviving rows; a summary takes the place of its group's last entry
+    struct Row {
+        std::string transactionId;
+        TransactionType type;
+        Money amount;
+        std::chrono::system_clock::rep timestamp;
+        std::string description;
+        AccountId fromAccount;
+        AccountId toAccount;
+        Money fromBalanceAfter;
+        Money toBalanceAfter;
+    };
+    std::vector<Row> rows;
+    rows.reserve(rowCount - result.rowsFolded + result.summariesWritten);
+    result.newRowOf.assign(rowCount, FoldResult::FOLDED);
+    result.foldedCredits.reserve(result.rowsFolded);
+    for (std::size_t row = 0; row < rowCount; ++row) {
+        const Group* group = groupOf[row] == NO_GROUP ? nullptr : &groups[groupOf[row]];
+        bool folded = group && group->count > 1;
+        if (folded) {
+            result.foldedCredits.push_back({toAccounts[row], timestampAt(row)});
+            if (row != group->lastRow) continue;
+        }
+        
+        Row copy{transactionIds[row], types[row], amounts[row], timestamps[row], descriptionAt(row),
+                 fromAccounts[row], toAccounts[row], fromBalancesAfter[row], toBalancesAfter[row]};
+        if (folded) {
+            // The summary row sits in its group's month, so its date names the period
+            char date[TextFormat::DATE_BUFFER];
+            TextFormat::formatDate(date, timestampAt(row));
+            copy.amount = group->amount;
+            copy.description = "Interest for " + std::string(date, 7) + " (" + std::to_string(group->count) + " credits)";
+            result.summaryRows.push_back(static_cast<std::uint32_t>(rows.size()));
+        } else {
+            result.newRowOf[row] = static_cast<std::uint32_t>(rows.size());
+        }
+        rows.push_back(std::move(copy));
+    }
+    
+    // Folded rows take their balances with them, so each account keeps the range it had
+    struct BalanceRange {
+        AccountId accountId;
+        Money low;
+        Money high;
+    };
+    std::vector<BalanceRange> ranges;
+    for (std::size_t id = 0; id < activity.size(); ++id) {
+        if (activity[id].hasBalanceRange) {
+            ranges.push_back({static_cast<AccountId>(id), activity[id].minBalance, activity[id].maxBalance});
+        }
+    }
+    
+    // Rebuild columns, postings, secondary indexes and activity from scratch
+    clear();
+    reserve(rows.size());
+    for (const Row& row : rows) {
+        appendRow(row.transactionId, row.type, row.amount, row.timestamp, row.description,
+                  row.fromAccount, row.toAccount, row.fromBalanceAfter, row.toBalanceAfter);
+    }
+    for (const BalanceRange& range : ranges) {
+        AccountActivity& rebuilt = activityFor(range.accountId);
+        rebuilt.includeBalance(range.low);
+        rebuilt.includeBalance(range.high);
+    }
+    return result;
+}
+
+Money TransactionLedger::sumAmounts(TransactionType type) const {
+    return MoneyKernels::sumWhere(amounts.data(), types.data(), type, types.size());
+}
+
+Money TransactionLedger::sumAmounts(TransactionType type, Span<const std::uint32_t> rows) const {
+    return MoneyKernels::sumWhere(amounts.data(), types.data(), type, rows.data(), rows.size());
+}
+
+Money TransactionLedger::smallestAmount() const {
+    return MoneyKernels::min(amounts.data(), amounts.size());
+}
+
+Money TransactionLedger::largestAmount() const {
+    return MoneyKernels::max(amounts.data(), amounts.size());
+}
+
+std::vector<std::uint32_t> TransactionLedger::rowsWithAmountBetween(Money low, Money high) const {
+    return MoneyKernels::selectBetween(amounts.data(), amounts.size(), low, high);
+}
+
+std::vector<std::uint32_t> TransactionLedger::select(const TransactionFilter& filter) const {
+    std::vector<std::uint32_t> result;
+    if (filter.hasAmountRange && filter.maxAmount < filter.minAmount) {
+        return result;
+    }
+    
+    // Candidate lists from the type and counterparty indexes
+    std::vector<Span<const std::uint32_t>> lists;
+    if (filter.hasType) {
+        lists.push_back(rowsOf(typeRows, static_cast<std::size_t>(filter.type)));
+    }
+    if (filter.counterparty != INVALID_ACCOUNT_ID) {
+        lists.push_back(rowsOf(postings, filter.counterparty));
+    }
+    
+    // The amount buckets are merged into a list only when they beat the others
+    std::vector<std::uint32_t> amountRows;
+    if (filter.hasAmountRange) {
+        std::size_t firstBucket = amountBucketOf(filter.minAmount);
+        std::size_t lastBucket = amountBucketOf(filter.maxAmount);
+        std::size_t bucketRows = 0;
+        for (std::size_t bucket = firstBucket; bucket <= lastBucket; ++bucket) {
+            bucketRows += rowsOf(amountBuckets, bucket).size();
+        }
+        
+        bool smallest = std::all_of(lists.begin(), lists.end(),
+                                    [bucketRows](Span<const std::uint32_t> rows) { return bucketRows < rows.size(); });
+        if (smallest) {
+            amountRows.reserve(bucketRows);
+            for (std::size_t bucket = firstBucket; bucket <= lastBucket; ++bucket) {
+                Span<const std::uint32_t> rows = rowsOf(amountBuckets, bucket);
+                amountRows.insert(amountRows.end(), rows.begin(), rows.end());
+            }
+            std::sort(amountRows.begin(), amountRows.end());
+            lists.push_back(Span<const std::uint32_t>(amountRows.data(), amountRows.size()));
+        }
+    }
+    
+    if (lists.empty()) {
+        for (std::size_t row = 0; row < size(); ++row) {
+            if (matches(filter, row)) result.push_back(static_cast<std::uint32_t>(row));
+        }
+        return result;
+    }
+    
+    // Drive from the shortest list and gallop through the rest; each cursor only
+    // moves forward, and the column check settles exact bounds and direction
+    std::sort(lists.begin(), lists.end(),
+              [](Span<const std::uint32_t> a, Span<const std::uint32_t> b) { return a.size() < b.size(); });
+    std::vector<const std::uint32_t*> cursors;
+    for (const auto& rows : lists) {
+        cursors.push_back(rows.begin());
+    }
+    
+    for (std::uint32_t row : lists[0]) {
+        bool inAll = true;
+        for (std::size_t i = 1; i < lists.size() && inAll; ++i) {
+            cursors[i] = std::lower_bound(cursors[i], lists[i].end(), row);
+            inAll = cursors[i] != lists[i].end() && *cursors[i] == row;
+        }
+        if (inAll && matches(filter, row)) {
+            result.push_back(row);
+        }
+    }
+    return result;
+}
+
+bool TransactionFilter::matches(TransactionType rowType, Money amount, AccountId from, AccountId to) const {
+    if (hasType && rowType != type) return false;
+    if (hasAmountRange && (amount < minAmount || maxAmount < amount)) return false;
+    if (counterparty == INVALID_ACCOUNT_ID) return true;
+    
+    switch (direction) {
+        case Direction::INTO: return to == counterparty;
+        case Direction::OUT_OF: return from == counterparty;
+        default: return from == counterparty || to == counterparty;
+    }
+}
+
+void TransactionLedger::addRow(Column<RowList>& lists, std::size_t key, std::size_t row) {
+    if (key >= lists.size()) {
+        lists.resize(key + 1, RowList(ArenaAllocator<std::uint32_t>(arena)));
+    }
+    lists[key].push_back(static_cast<std::uint32_t>(row));
+}
+
+Span<const std::uint32_t> TransactionLedger::rowsOf(const Column<RowList>& lists, std::size_t key) {
+    return key < lists.size() ? Span<const std::uint32_t>(lists[key].data(), lists[key].size())
+                              : Span<const std::uint32_t>();
+}
+
+std::size_t TransactionLedger::amountBucketOf(Money amount) {
+    // Bucket b holds amounts of b significant bits in cents; zero and below share bucket 0
+    std::int64_t cents = amount.getCents();
+    std::size_t bucket = 0;
+    while (cents > 0) {
+        ++bucket;
+        cents >>= 1;
+    }
+    return bucket;
+}
+
+LedgerView TransactionLedger::history(AccountId accountId) const {
+    if (accountId >= postings.size()) {
+        return LedgerView();
+    }
+    return LedgerView(*this, rowsOf(postings, accountId), accountId);
+}
+
+const AccountActivity& TransactionLedger::activityOf(AccountId accountId) const {
+    static const AccountActivity none;
+    return accountId < activity.size() ? activity[accountId] : none;
+}
+
+void TransactionLedger::recordActivity(AccountId accountId, TransactionType type, Money amount,
+                                       std::chrono::system_clock::rep timestamp, Money balanceAfter, AccountId counterparty) {
+    activityFor(accountId).record(type, amount, timestamp, balanceAfter, counterparty);
+}
+
+AccountActivity& TransactionLedger::activityFor(AccountId accountId) {
+    if (accountId >= activity.size()) {
+        activity.resize(accountId + 1);
+    }
+    return activity[accountId];
+}
+
+void AccountActivity::record(TransactionType type, Money amount, std::chrono::system_clock::rep timestamp,
+                             Money balanceAfter, AccountId counterparty) {
+    if (!hasActivity()) {
+        firstTimestamp = timestamp;
+    }
+    amounts[static_cast<std::size_t>(type)] += amount;
+    ++counts[static_cast<std::size_t>(type)];
+    lastTimestamp = timestamp;
+    includeBalance(balanceAfter);
+    
+    if (counterparty != INVALID_ACCOUNT_ID) {
+        if (!counterparties) {
+            counterparties = std::make_unique<HyperLogLog>();
+        }
+        counterparties->add(counterparty);
+    }
+}
+
+void AccountActivity::includeBalance(Money balance) {
+    if (!hasBalanceRange) {
+        minBalance = balance;
+        maxBalance = balance;
+        hasBalanceRange = true;
+        return;
+    }
+    minBalance = std::min(minBalance, balance);
+    maxBalance = std::max(maxBalance, balance);
+}
+
+std::uint32_t AccountActivity::transactionCount() const {
+    std::uint32_t total = 0;
+    for (std::uint32_t count : counts) {
+        total += count;
+    }
+    return total;
+}
+
+LedgerRange TransactionLedger::page(std::size_t offset, std::size_t limit) const {
+    std::size_t first = std::min(offset, size());
+    return LedgerRange(*this, first, first + std::min(limit, size() - first));
+}
+
+LedgerRange TransactionLedger::between(std::chrono::system_clock::time_point start,
+                                      std::chrono::system_clock::time_point end) const {
+    auto first = std::lower_bound(timestamps.begin(), timestamps.end(), start.time_since_epoch().count());
+    auto last = std::lower_bound(first, timestamps.end(), end.time_since_epoch().count());
+    return LedgerRange(*this, first - timestamps.begin(), last - timestamps.begin());
+}
+
+LedgerView LedgerView::between(std::chrono::system_clock::time_point start,
+                               std::chrono::system_clock::time_point end) const {
+    if (!ledger) {
+        return *this;
+    }
+    
+    // Posting rows ascend, and so do their timestamps
+    const auto& timestamps = ledger->getTimestamps();
+    auto before = [&timestamps](std::uint32_t row, std::chrono::system_clock::rep time) { return timestamps[row] < time; };
+    const std::uint32_t* first = std::lower_bound(rows.begin(), rows.end(), start.time_since_epoch().count(), before);
+    const std::uint32_t* last = std::lower_bound(first, rows.end(), end.time_since_epoch().count(), before);
+    return LedgerView(*ledger, Span<const std::uint32_t>(first, last - first), perspective);
+}
+
+LedgerView LedgerView::after(std::size_t row, std::size_t limit) const {
+    // Posting lists are in ascending row order, so the cursor is a binary search
+    const std::uint32_t* next = std::upper_bound(rows.begin(), rows.end(), row);
+    return page(static_cast<std::size_t>(next - rows.begin()), limit);
+}
+
+std::size_t TransactionLedger::countOf(TransactionType type) const {
+    const TransactionType* typeColumn = types.data();
+    std::size_t rows = types.size();
+    
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < rows; ++i) {
+        count += typeColumn[i] == type;
+    }
+    return count;
+}
+
+const std::string& TransactionLedger::accountNumberOf(AccountId id) const {
+    static const std::string none;
+    return accountRegistry ? accountRegistry->numberOf(id) : none;
+}
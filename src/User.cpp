@@ -1,9 +1,7 @@
 #include "User.h"
-#include <random>
-#include <sstream>
-#include <iomanip>
+#include "IdGenerator.h"
+#include "TextFormat.h"
 #include <chrono>
-#include <ctime>
 #include <algorithm>
 
 User::User(const std::string& user, const std::string& pass, const std::string& first, 
@@ -18,34 +16,19 @@ User::User(const std::string& user, const std::string& pass, const std::string&
 }
 
 void User::generateUserId() {
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<> dis(100000000, 999999999);
-    
-    std::ostringstream oss;
-    oss << "USR" << std::setw(9) << std::setfill('0') << dis(gen);
-    userId = oss.str();
+    userId = IdGenerator::nextUserId();
 }
 
 std::string User::getFullName() const {
     return firstName + " " + lastName;
 }
 
-void User::addAccount(std::shared_ptr<Account> account) {
-    accounts.push_back(account);
+void User::addAccount(AccountHandle account) {
+    accountHandles.push_back(account);
 }
 
-std::vector<std::shared_ptr<Account>> User::getAccounts() const {
-    return accounts;
-}
-
-std::shared_ptr<Account> User::getAccount(const std::string& accountNumber) const {
-    for (const auto& account : accounts) {
-        if (account->getAccountNumber() == accountNumber) {
-            return account;
-        }
-    }
-    return nullptr;
+bool User::ownsAccount(AccountHandle account) const {
+    return std::find(accountHandles.begin(), accountHandles.end(), account) != accountHandles.end();
 }
 
 bool User::authenticate(const std::string& password) const {
@@ -62,12 +45,25 @@ void User::recordLogin() {
 
 void User::updateProfile(const std::string& first, const std::string& last, 
                         const std::string& emailAddr, const std::string& phone) {
+    if (onProfileChangeCallback) {
+        onProfileChangeCallback(*this, first, last, emailAddr, phone);
+    }
+    
     firstName = first;
     lastName = last;
     email = emailAddr;
     phoneNumber = phone;
 }
 
+bool User::replaceAccount(AccountHandle previous, AccountHandle current) {
+    auto found = std::find(accountHandles.begin(), accountHandles.end(), previous);
+    if (found == accountHandles.end()) {
+        return false;
+    }
+    *found = current;
+    return true;
+}
+
 std::string User::getRoleString() const {
     switch (role) {
         case UserRole::CUSTOMER: return "Customer";
@@ -77,12 +73,8 @@ std::string User::getRoleString() const {
 }
 
 std::string User::getFormattedLastLogin() const {
-    auto time_t = std::chrono::system_clock::to_time_t(lastLogin);
-    std::tm* tm = std::localtime(&time_t);
-    
-    std::ostringstream oss;
-    oss << std::put_time(tm, "%Y-%m-%d %H:%M:%S");
-    return oss.str();
+    char buffer[TextFormat::TIMESTAMP_BUFFER];
+    return std::string(buffer, TextFormat::formatTimestamp(buffer, lastLogin));
 }
 
 std::string User::hashPassword(const std::string& password) const {